@@ -0,0 +1,131 @@
+% Camera.Replay - Camera backend that plays frames from a recorded session.
+% Frames are delivered in the order they were recorded, either at the pace
+% they were recorded (speed 1) or as fast as they are consumed (speed Inf).
+% The backend may be passed to Camera to drive the complete pipeline:
+%   recording = VirtualTracker.Recorder.Load('session.mat');
+%   camera = Camera(Camera.Replay(recording, 1));
+%
+% Frames are replayed as seen by the tracker during the recording (i.e.
+% after mirroring and at the recorded scale). The resolution reported is
+% that of the recorded frames and cannot be changed.
+%
+% Camera.Replay properties:
+%   count - Number of frames delivered.
+%   speed - Playback speed relative to the recording; Inf for maximum speed.
+%
+% See also Camera, VirtualTracker.Recorder, VirtualTracker.Replayer.
+
+% 2026-10-18. Leonardo Molina.
+% 2026-10-18. Last modified.
+classdef Replay < Event % pretend-CameraInterface
+    properties (Dependent)
+        % hasFrame - Whether a new frame is available.
+        hasFrame
+        
+        % exposure - Set/get the exposure; kept but without effect on frames.
+        exposure
+        
+        % exposureRange - Exposure range.
+        exposureRange
+        
+        % resolutionIndex - Index of the resolution of the current frame.
+        resolutionIndex
+        
+        % resolutionList - List of resolutions found in the recording.
+        resolutionList
+    end
+    
+    properties (SetAccess = private)
+        % count - Number of frames delivered.
+        count = 0
+        
+        % speed - Playback speed relative to the recording; Inf for maximum speed.
+        speed
+    end
+    
+    properties (Access = private)
+        frames
+        range
+        times
+        mExposure = 0
+        mResolutionIndex = 1
+        mResolutionList
+        startTime
+    end
+    
+    methods
+        function obj = Replay(recording, speed)
+            % Camera.Replay(recording, <speed>)
+            % Play frames from a recording (see VirtualTracker.Recorder) at
+            % the given speed (default 1).
+            
+            if nargin < 2
+                speed = 1;
+            end
+            if ~isnumeric(speed) || ~isscalar(speed) || speed <= 0
+                error('Value provided for speed is invalid.');
+            end
+            obj.speed = speed;
+            obj.range = recording.exposureRange;
+            obj.frames = recording.frames;
+            obj.times = recording.frameTimes - recording.frameTimes(1);
+            sizes = cellfun(@(frame) [size(frame, 1); size(frame, 2)], obj.frames, 'UniformOutput', false);
+            obj.mResolutionList = unique([sizes{:}]', 'rows', 'stable')';
+        end
+        
+        function frame = getFrame(obj, block)
+            % frame = Camera.Replay.getFrame(<block>)
+            % Return the next recorded frame, or the last one when the
+            % recording is over. If block is true, wait until the frame is
+            % due according to speed.
+            
+            if nargin == 2 && block && obj.count < numel(obj.frames)
+                while ~obj.hasFrame
+                    pause(1e-3);
+                end
+            end
+            if obj.hasFrame
+                % The clock starts with the first frame delivered.
+                if obj.count == 0
+                    obj.startTime = tic;
+                end
+                obj.count = obj.count + 1;
+                resolution = [size(obj.frames{obj.count}, 1); size(obj.frames{obj.count}, 2)];
+                index = find(all(obj.resolutionList == resolution, 1), 1);
+                if index ~= obj.mResolutionIndex
+                    obj.mResolutionIndex = index;
+                    obj.invoke('Resolution', resolution);
+                end
+            end
+            frame = obj.frames{max(obj.count, 1)};
+        end
+        
+        function hasFrame = get.hasFrame(obj)
+            hasFrame = obj.count < numel(obj.frames) && (obj.count == 0 || isinf(obj.speed) || toc(obj.startTime) * obj.speed >= obj.times(obj.count + 1));
+        end
+        
+        function set.exposure(obj, exposure)
+            obj.mExposure = exposure;
+        end
+        
+        function exposure = get.exposure(obj)
+            exposure = obj.mExposure;
+        end
+        
+        function range = get.exposureRange(obj)
+            range = obj.range;
+        end
+        
+        function set.resolutionIndex(~, ~)
+            % Resolution is given by the recorded frames.
+        end
+        
+        function index = get.resolutionIndex(obj)
+            index = obj.mResolutionIndex;
+        end
+        
+        function list = get.resolutionList(obj)
+            list = obj.mResolutionList;
+        end
+    end
+end
\ No newline at end of file
@@ -0,0 +1,268 @@
+% Camera.Synthetic - Deterministic generator of arena scenes.
+% Renders an arena with blobs that follow scripted or random-walk
+% trajectories, with pixel noise, lighting drift and occlusions, and records
+% the ground-truth position of every blob. The generator behaves like any
+% other camera backend and may be passed to Camera to drive the complete
+% pipeline without hardware:
+%   camera = Camera(Camera.Synthetic('Blobs', 2, 'Seed', 1));
+%
+% Scenes only depend on the parameters and the seed: the n-th frame is
+% always rendered at time n / Rate, regardless of the time it takes to
+% render or consume it.
+%
+% Camera.Synthetic parameters (name-value pairs):
+%   Blobs       - Number of blobs (default 1).
+%   Colors      - RGB color of each blob (n-by-3, 0..1). Empty for unmarked
+%                 dark blobs (default).
+%   Drift       - Relative amplitude of a slow lighting drift (default 0).
+%   Noise       - Standard deviation of pixel noise, in gray levels (default 0).
+%   Occlusions  - Number of static occluders placed at random (default 0).
+%   Radius      - Blob radius, normalized to the smallest image dimension (default 0.03).
+%   Rate        - Frame rate (Hz). When Inf, a new frame is always
+%                 available and time advances at 30 Hz (default Inf).
+%   Resolutions - List of resolutions [height; width] (default 120x160 to 1080x1920).
+%   Seed        - Seed of the random number generator (default 0).
+%   Speed       - Speed of random walks, in normalized units per second (default 0.2).
+%   Trajectory  - Function handle @(t) returning a 2-by-Blobs array with
+%                 normalized positions at time t (s). Blobs follow random
+%                 walks when empty (default).
+%
+% Camera.Synthetic properties:
+%   truth - Ground truth with fields Frame, Time, X, Y and Visible, one row
+%           per frame rendered and one column per blob. X and Y are
+%           normalized and referenced to the center of the image.
+%
+% See also Camera, Tools.normalize.
+
+% 2026-10-18. Leonardo Molina.
+% 2026-10-18. Last modified.
+classdef Synthetic < Event % pretend-CameraInterface
+    properties (Dependent)
+        % hasFrame - Whether a new frame is available.
+        hasFrame
+        
+        % exposure - Set/get the exposure (relative gain, 0 is neutral).
+        exposure
+        
+        % exposureRange - Exposure range.
+        exposureRange
+        
+        % resolutionIndex - Index of selected resolution.
+        resolutionIndex
+        
+        % resolutionList - List of available resolutions.
+        resolutionList
+    end
+    
+    properties (SetAccess = private)
+        % truth - Ground truth for every frame rendered.
+        truth = struct('Frame', zeros(0, 1), 'Time', zeros(0, 1), 'X', [], 'Y', [], 'Visible', false(0, 0))
+    end
+    
+    properties (Access = private)
+        % Scene parameters.
+        colors
+        drift
+        noise
+        nBlobs
+        occluders
+        radius
+        rate
+        speed
+        trajectory
+        
+        % State.
+        count = 0
+        frameTime
+        headings
+        mExposure = 0
+        mResolutionIndex = 1
+        mResolutionList
+        positions
+        stream
+    end
+    
+    methods
+        function obj = Synthetic(varargin)
+            % Camera.Synthetic(<name1>, <value1>, <name2>, <value2>, ...)
+            % Create a scene generator with the given parameters.
+            
+            parser = inputParser();
+            parser.addParameter('Blobs', 1);
+            parser.addParameter('Colors', []);
+            parser.addParameter('Drift', 0);
+            parser.addParameter('Noise', 0);
+            parser.addParameter('Occlusions', 0);
+            parser.addParameter('Radius', 0.03);
+            parser.addParameter('Rate', Inf);
+            parser.addParameter('Resolutions', [120, 240, 480, 720, 1080; 160, 320, 640, 1280, 1920]);
+            parser.addParameter('Seed', 0);
+            parser.addParameter('Speed', 0.2);
+            parser.addParameter('Trajectory', []);
+            parser.parse(varargin{:});
+            p = parser.Results;
+            
+            obj.nBlobs = p.Blobs;
+            obj.colors = p.Colors;
+            obj.drift = p.Drift;
+            obj.noise = p.Noise;
+            obj.radius = p.Radius;
+            obj.rate = p.Rate;
+            obj.speed = p.Speed;
+            obj.trajectory = p.Trajectory;
+            obj.mResolutionList = p.Resolutions;
+            obj.stream = RandStream('mt19937ar', 'Seed', p.Seed);
+            
+            % Start blobs at random positions and headings within the central area.
+            obj.positions = 0.25 * (2 * rand(obj.stream, 2, obj.nBlobs) - 1);
+            obj.headings = 2 * pi * rand(obj.stream, 1, obj.nBlobs);
+            % Occluders: rectangles [x1; y1; x2; y2] in normalized units.
+            corners = rand(obj.stream, 2, p.Occlusions) - 0.5;
+            sizes = 0.05 + 0.10 * rand(obj.stream, 2, p.Occlusions);
+            obj.occluders = [corners; corners + sizes];
+            obj.frameTime = tic;
+        end
+        
+        function frame = getFrame(obj, block)
+            % frame = Camera.Synthetic.getFrame(<block>)
+            % Render the next frame. If block is true, wait until the frame
+            % is due according to Rate.
+            
+            if nargin == 2 && block
+                while ~obj.hasFrame
+                    pause(1e-3);
+                end
+            end
+            obj.frameTime = tic;
+            obj.count = obj.count + 1;
+            if isfinite(obj.rate)
+                t = obj.count / obj.rate;
+                dt = 1 / obj.rate;
+            else
+                t = obj.count / 30;
+                dt = 1 / 30;
+            end
+            obj.step(t, dt);
+            frame = obj.render(t);
+        end
+        
+        function hasFrame = get.hasFrame(obj)
+            hasFrame = ~isfinite(obj.rate) || toc(obj.frameTime) >= 1 / obj.rate;
+        end
+        
+        function set.exposure(obj, exposure)
+            obj.mExposure = min(max(exposure, obj.exposureRange(1)), obj.exposureRange(2));
+        end
+        
+        function exposure = get.exposure(obj)
+            exposure = obj.mExposure;
+        end
+        
+        function range = get.exposureRange(~)
+            range = [-1, 1];
+        end
+        
+        function set.resolutionIndex(obj, index)
+            if index ~= obj.mResolutionIndex && index > 0 && index <= size(obj.resolutionList, 2)
+                obj.mResolutionIndex = index;
+                obj.invoke('Resolution', obj.resolutionList(:, index));
+            end
+        end
+        
+        function index = get.resolutionIndex(obj)
+            index = obj.mResolutionIndex;
+        end
+        
+        function list = get.resolutionList(obj)
+            list = obj.mResolutionList;
+        end
+    end
+    
+    methods (Access = private)
+        function step(obj, t, dt)
+            % Camera.Synthetic.step(t, dt)
+            % Advance blob positions to time t.
+            
+            resolution = obj.resolutionList(:, obj.resolutionIndex);
+            d = min(resolution);
+            limits = 0.5 * [resolution(2); resolution(1)] / d - obj.radius;
+            if isempty(obj.trajectory)
+                % Correlated random walk, reflected at the walls.
+                obj.headings = obj.headings + 0.5 * randn(obj.stream, 1, obj.nBlobs);
+                obj.positions = obj.positions + obj.speed * dt * [cos(obj.headings); sin(obj.headings)];
+                for a = 1:2
+                    over = abs(obj.positions(a, :)) > limits(a);
+                    obj.positions(a, over) = sign(obj.positions(a, over)) .* (2 * limits(a) - abs(obj.positions(a, over)));
+                    if a == 1
+                        obj.headings(over) = pi - obj.headings(over);
+                    else
+                        obj.headings(over) = -obj.headings(over);
+                    end
+                end
+            else
+                obj.positions = obj.trajectory(t);
+            end
+        end
+        
+        function frame = render(obj, t)
+            % frame = Camera.Synthetic.render(t)
+            % Render the scene at time t and record the ground truth.
+            
+            resolution = obj.resolutionList(:, obj.resolutionIndex);
+            h = resolution(1);
+            w = resolution(2);
+            d = min(h, w);
+            gain = (1 + 0.5 * obj.mExposure) * (1 + obj.drift * sin(2 * pi * t / 60));
+            
+            % Bright arena with dark or colored blobs.
+            frame = repmat(reshape([200, 200, 200], 1, 1, 3), h, w);
+            [px, py] = Tools.pixelate(obj.positions(1, :), obj.positions(2, :), w, h);
+            r = obj.radius * d;
+            for b = 1:obj.nBlobs
+                i1 = max(1, floor(py(b) - r));
+                i2 = min(h, ceil(py(b) + r));
+                j1 = max(1, floor(px(b) - r));
+                j2 = min(w, ceil(px(b) + r));
+                [jj, ii] = meshgrid(j1:j2, i1:i2);
+                inside = (jj - px(b)) .^ 2 + (ii - py(b)) .^ 2 <= r ^ 2;
+                if isempty(obj.colors)
+                    color = [30, 30, 30];
+                else
+                    color = 255 * obj.colors(b, :);
+                end
+                for c = 1:3
+                    patch = frame(i1:i2, j1:j2, c);
+                    patch(inside) = color(c);
+                    frame(i1:i2, j1:j2, c) = patch;
+                end
+            end
+            
+            % Occluders are drawn on top of the blobs.
+            visible = true(1, obj.nBlobs);
+            for o = 1:size(obj.occluders, 2)
+                box = obj.occluders(:, o);
+                [x1, y1] = Tools.pixelate(box(1), box(2), w, h);
+                [x2, y2] = Tools.pixelate(box(3), box(4), w, h);
+                i1 = max(1, round(y1));
+                i2 = min(h, round(y2));
+                j1 = max(1, round(x1));
+                j2 = min(w, round(x2));
+                frame(i1:i2, j1:j2, :) = 120;
+                visible = visible & ~(obj.positions(1, :) >= box(1) & obj.positions(1, :) <= box(3) & obj.positions(2, :) >= box(2) & obj.positions(2, :) <= box(4));
+            end
+            
+            frame = gain * frame;
+            if obj.noise > 0
+                frame = frame + obj.noise * randn(obj.stream, h, w, 3);
+            end
+            frame = uint8(frame);
+            
+            n = obj.count;
+            obj.truth.Frame(n, 1) = n;
+            obj.truth.Time(n, 1) = t;
+            obj.truth.X(n, 1:obj.nBlobs) = obj.positions(1, :);
+            obj.truth.Y(n, 1:obj.nBlobs) = obj.positions(2, :);
+            obj.truth.Visible(n, 1:obj.nBlobs) = visible;
+        end
+    end
+end
\ No newline at end of file
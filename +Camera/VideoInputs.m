@@ -33,12 +33,14 @@ classdef VideoInputs < Event % pretend-CameraInterface
     end
 
     methods
-        function obj = VideoInputs(id)
-            % VideoInputs(<camera_id>)
+        function obj = VideoInputs(id, ~)
+            % VideoInputs(<camera_id>, <capabilities>)
+            % Capabilities are not probed; the argument is accepted for
+            % compatibility with cached backends.
             
             success = false;
             className = mfilename('class');
-            cameraNames = webcamlist();
+            cameraNames = Camera.Names();
             if nargin == 0
                 id = 1;
             end
@@ -91,6 +93,16 @@ classdef VideoInputs < Event % pretend-CameraInterface
             end
         end
         
+        function capabilities = capabilities(obj)
+            % capabilities = VideoInputs.capabilities()
+            % Capabilities to be cached across sessions.
+            
+            capabilities.exposureAvailable = false;
+            capabilities.exposureRange = obj.exposureRange;
+            capabilities.resolutionList = obj.resolutionList;
+            capabilities.resolutionNames = {};
+        end
+        
         function delete(obj)
             delete(obj.scheduler);
             flushdata(obj.camera);
@@ -40,12 +40,14 @@ classdef Webcams < Event % pretent-CameraInterface
     end
     
     methods
-        function obj = Webcams(id)
-            % Webcams(<camera_id>)
+        function obj = Webcams(id, capabilities)
+            % Webcams(<camera_id>, <capabilities>)
+            % Probing of exposure range and resolutions is skipped when
+            % capabilities cached from a previous session are provided.
             
             success = false;
             className = mfilename('class');
-            cameraNames = webcamlist();
+            cameraNames = Camera.Names();
             if nargin == 0
                 id = 1;
             end
@@ -88,7 +90,19 @@ classdef Webcams < Event % pretent-CameraInterface
             end
             
             if success
-                if redo
+                if redo && nargin == 2
+                    % Capabilities known from a previous session.
+                    obj.mExposureAvailable = capabilities.exposureAvailable;
+                    obj.mExposureRange = capabilities.exposureRange;
+                    obj.mResolutionNames = capabilities.resolutionNames;
+                    obj.mResolutionList = capabilities.resolutionList;
+                    if obj.mExposureAvailable
+                        obj.camera.ExposureMode = 'manual';
+                        obj.exposure = 0.9 * sum(obj.exposureRange);
+                    else
+                        obj.mExposure = Inf;
+                    end
+                elseif redo
                     try
                         obj.camera.ExposureMode = 'manual';
                         obj.mExposureAvailable = true;
@@ -107,7 +121,7 @@ classdef Webcams < Event % pretent-CameraInterface
                         obj.mExposure = Inf;
                         obj.mExposureRange = [Inf Inf];
                     end
-
+                    
                     % Populate resolution list.
                     res = obj.camera.AvailableResolutions;
                     mres = strsplit(strjoin(res, 'x'), 'x');
@@ -116,6 +130,8 @@ classdef Webcams < Event % pretent-CameraInterface
                     [mres, o] = sortrows(mres);
                     obj.mResolutionNames = res(o);
                     obj.mResolutionList = mres';
+                end
+                if redo
                     % Choose minimum resolution.
                     obj.resolutionIndex = 1;
                     % Start frame for getFrame(false).
@@ -131,6 +147,16 @@ classdef Webcams < Event % pretent-CameraInterface
             Objects.delete(obj.camera);
         end
         
+        function capabilities = capabilities(obj)
+            % capabilities = Webcams.capabilities()
+            % Probed capabilities, to be cached across sessions.
+            
+            capabilities.exposureAvailable = obj.mExposureAvailable;
+            capabilities.exposureRange = obj.mExposureRange;
+            capabilities.resolutionList = obj.mResolutionList;
+            capabilities.resolutionNames = obj.mResolutionNames;
+        end
+        
         function frame = getFrame(obj, block)
             if nargin < 2
                 block = false;
@@ -0,0 +1,268 @@
+function [results, recommended] = benchmark(varargin)
+    % [results, recommended] = Target.benchmark(<name1>, <value1>, ...)
+    % Compare zone-testing variants across zone counts, zone shapes, pointer
+    % speeds and number of pointers tested per call. Each variant reports
+    % states (zones-by-pointers) for the segment traversed by each pointer
+    % since the previous frame:
+    %   grid     - Target.test: rasterized masks, one pointer per call.
+    %   analytic - Exact point-in-circle / point-in-polygon tests of points
+    %              sampled along each segment.
+    %   culled   - Same as analytic, but only for zones whose bounding box
+    %              overlaps the bounding box of a segment. Zones are sorted
+    %              by their left edge once per set of zones (not timed), so
+    %              that candidates are found with a binary search.
+    % Correctness is checked against a reference that samples segments ten
+    % times more densely than the significance of the zones. Disagreements
+    % of the grid variant are expected within one significance unit of
+    % zone edges.
+    %
+    % Parameters (name-value pairs):
+    %   Batches      - Pointers tested per frame (default [1, 16]).
+    %   Counts       - Number of zones (default [1, 10, 100, 1000, 5000]).
+    %   Motions      - 'stationary' and/or 'fast' (default both).
+    %   Output       - JSON file where results are saved (default none).
+    %   Shapes       - 'circle', 'polygon' and/or 'mixed' (default all).
+    %   Significance - Resolution of zones, as in Target.add (default 0.01).
+    %   Seed         - Seed of zone and path generation (default 0).
+    %   Steps        - Frames per case (default 100).
+    %   Tolerance    - Proportion of disagreements with the reference
+    %                  accepted when recommending a variant (default 1e-3).
+    %
+    % Returns results, one element per case and variant, and recommended,
+    % the fastest variant within tolerance for each case.
+    %
+    % Example:
+    %   [results, recommended] = Target.benchmark('Counts', [10, 1000], 'Output', 'zones.json');
+    %   disp(struct2table(recommended));
+    %
+    % See also Target, Tracker.benchmark.
+    
+    % 2026-10-18. Leonardo Molina.
+    % 2026-10-18. Last modified.
+    
+    parser = inputParser();
+    parser.addParameter('Batches', [1, 16]);
+    parser.addParameter('Counts', [1, 10, 100, 1000, 5000]);
+    parser.addParameter('Motions', {'stationary', 'fast'});
+    parser.addParameter('Output', '');
+    parser.addParameter('Shapes', {'circle', 'polygon', 'mixed'});
+    parser.addParameter('Significance', 0.01);
+    parser.addParameter('Seed', 0);
+    parser.addParameter('Steps', 100);
+    parser.addParameter('Tolerance', 1e-3);
+    parser.parse(varargin{:});
+    p = parser.Results;
+    
+    variants = {'grid', 'analytic', 'culled'};
+    results = struct('name', {}, 'variant', {}, 'zones', {}, 'shape', {}, 'motion', {}, 'batch', {}, 'median', {}, 'p90', {}, 'rate', {}, 'mismatches', {});
+    recommended = struct('name', {}, 'variant', {}, 'median', {});
+    for count = p.Counts
+        for shape = p.Shapes
+            stream = RandStream('mt19937ar', 'Seed', p.Seed);
+            zones = createZones(stream, count, shape{1});
+            index = createIndex(zones);
+            target = Target();
+            for z = 1:count
+                target.add(zones(z).x, zones(z).y, p.Significance);
+            end
+            for motion = p.Motions
+                for batch = p.Batches
+                    [xs, ys] = createPaths(stream, motion{1}, batch, p.Steps);
+                    truth = cell(1, p.Steps);
+                    for s = 1:p.Steps
+                        truth{s} = testAnalytic(zones, xs(:, :, s), ys(:, :, s), 0.1 * p.Significance);
+                    end
+                    name = sprintf('%s/zones%i/%s/pointers%i', shape{1}, count, motion{1}, batch);
+                    best = struct('name', name, 'variant', '', 'median', Inf);
+                    for v = 1:numel(variants)
+                        times = zeros(1, p.Steps);
+                        mismatches = 0;
+                        for s = 1:p.Steps
+                            start = tic;
+                            switch variants{v}
+                                case 'grid'
+                                    states = testGrid(target, count, xs(:, :, s), ys(:, :, s));
+                                case 'analytic'
+                                    states = testAnalytic(zones, xs(:, :, s), ys(:, :, s), p.Significance);
+                                case 'culled'
+                                    states = testCulled(zones, index, xs(:, :, s), ys(:, :, s), p.Significance);
+                            end
+                            times(s) = toc(start);
+                            mismatches = mismatches + sum(states(:) ~= truth{s}(:));
+                        end
+                        times = sort(times);
+                        result.name = name;
+                        result.variant = variants{v};
+                        result.zones = count;
+                        result.shape = shape{1};
+                        result.motion = motion{1};
+                        result.batch = batch;
+                        result.median = 1e3 * median(times);
+                        result.p90 = 1e3 * times(max(1, ceil(0.9 * numel(times))));
+                        result.rate = batch / mean(times);
+                        result.mismatches = mismatches / (count * batch * p.Steps);
+                        results(end + 1) = result; %#ok<AGROW>
+                        fprintf('%-40s %-8s %9.3fms %10.0f pointers/s %7.4f%% mismatches\n', name, variants{v}, result.median, result.rate, 100 * result.mismatches);
+                        if result.mismatches <= p.Tolerance && result.median < best.median
+                            best.variant = variants{v};
+                            best.median = result.median;
+                        end
+                    end
+                    recommended(end + 1) = best; %#ok<AGROW>
+                end
+            end
+            delete(target);
+        end
+    end
+    
+    if ~isempty(p.Output)
+        fid = fopen(p.Output, 'w');
+        fprintf(fid, '%s', jsonencode(struct('results', results, 'recommended', recommended)));
+        fclose(fid);
+    end
+end
+
+function zones = createZones(stream, count, shape)
+    % zones = createZones(stream, count, shape)
+    % Scatter count zones with radii that shrink as the number of zones grows.
+    
+    zones = struct('x', cell(1, count), 'y', [], 'box', [], 'circle', []);
+    radius = max(0.005, 0.2 / sqrt(count));
+    for z = 1:count
+        cx = rand(stream) - 0.5;
+        cy = rand(stream) - 0.5;
+        r = radius * (0.5 + rand(stream));
+        isCircle = strcmp(shape, 'circle') || (strcmp(shape, 'mixed') && mod(z, 2) == 1);
+        if isCircle
+            [xs, ys] = Tools.region([cx, cy, r], 32);
+            zones(z).circle = [cx, cy, r];
+        else
+            % Star-shaped polygon with 5 to 8 vertices.
+            n = 5 + floor(4 * rand(stream));
+            angles = sort(2 * pi * rand(stream, 1, n));
+            radii = r * (0.4 + 0.6 * rand(stream, 1, n));
+            xs = cx + radii .* cos(angles);
+            ys = cy + radii .* sin(angles);
+        end
+        zones(z).x = xs;
+        zones(z).y = ys;
+        zones(z).box = [min(xs), min(ys), max(xs), max(ys)];
+    end
+end
+
+function [xs, ys] = createPaths(stream, motion, batch, nSteps)
+    % [xs, ys] = createPaths(stream, motion, batch, nSteps)
+    % Segments [previous; current] for each pointer (columns) and step (pages).
+    
+    switch motion
+        case 'stationary'
+            speed = 0.001;
+        case 'fast'
+            speed = 0.2;
+        otherwise
+            error('Value provided for motion is invalid.');
+    end
+    positions = zeros(2, batch, nSteps + 1);
+    positions(:, :, 1) = rand(stream, 2, batch) - 0.5;
+    for s = 1:nSteps
+        headings = 2 * pi * rand(stream, 1, batch);
+        step = positions(:, :, s) + speed * [cos(headings); sin(headings)];
+        positions(:, :, s + 1) = min(max(step, -0.5), 0.5);
+    end
+    xs = [positions(1, :, 1:end - 1); positions(1, :, 2:end)];
+    ys = [positions(2, :, 1:end - 1); positions(2, :, 2:end)];
+end
+
+function states = testGrid(target, count, xs, ys)
+    % states = testGrid(target, count, xs, ys)
+    % Target.test, one pointer at a time.
+    
+    batch = size(xs, 2);
+    states = false(count, batch);
+    for b = 1:batch
+        states(:, b) = target.test(xs(:, b), ys(:, b), [false, false]);
+    end
+end
+
+function states = testAnalytic(zones, xs, ys, spacing)
+    % states = testAnalytic(zones, xs, ys, spacing)
+    % Exact tests of points sampled along each segment.
+    
+    batch = size(xs, 2);
+    states = false(numel(zones), batch);
+    for b = 1:batch
+        [px, py] = sample(xs(:, b), ys(:, b), spacing);
+        for z = 1:numel(zones)
+            states(z, b) = inside(zones(z), px, py);
+        end
+    end
+end
+
+function index = createIndex(zones)
+    % index = createIndex(zones)
+    % Bounding boxes of zones, sorted by their left edge.
+    
+    boxes = reshape([zones.box], 4, []);
+    [index.left, index.order] = sort(boxes(1, :));
+    index.boxes = boxes(:, index.order);
+end
+
+function states = testCulled(zones, index, xs, ys, spacing)
+    % states = testCulled(zones, index, xs, ys, spacing)
+    % Exact tests restricted to zones whose bounding box overlaps a segment.
+    
+    boxes = index.boxes;
+    batch = size(xs, 2);
+    states = false(numel(zones), batch);
+    for b = 1:batch
+        % Zones starting right of the segment cannot overlap it.
+        last = bisect(index.left, max(xs(:, b)));
+        candidates = find(boxes(3, 1:last) >= min(xs(:, b)) & boxes(2, 1:last) <= max(ys(:, b)) & boxes(4, 1:last) >= min(ys(:, b)));
+        if ~isempty(candidates)
+            [px, py] = sample(xs(:, b), ys(:, b), spacing);
+            for c = candidates
+                z = index.order(c);
+                states(z, b) = inside(zones(z), px, py);
+            end
+        end
+    end
+end
+
+function last = bisect(values, value)
+    % last = bisect(values, value)
+    % Number of elements of the sorted values that are not greater than value.
+    
+    low = 0;
+    high = numel(values);
+    while low < high
+        middle = ceil((low + high) / 2);
+        if values(middle) <= value
+            low = middle;
+        else
+            high = middle - 1;
+        end
+    end
+    last = low;
+end
+
+function [px, py] = sample(xs, ys, spacing)
+    % [px, py] = sample(xs, ys, spacing)
+    % Points along a segment, no further apart than spacing.
+    
+    n = max(1, ceil(hypot(diff(xs), diff(ys)) / spacing));
+    t = (0:n) / n;
+    px = xs(1) + t * diff(xs);
+    py = ys(1) + t * diff(ys);
+end
+
+function state = inside(zone, px, py)
+    % state = inside(zone, px, py)
+    % Whether any point lands within the zone.
+    
+    if isempty(zone.circle)
+        [a, b] = inpolygon(px, py, zone.x, zone.y);
+        state = any(a | b);
+    else
+        state = any((px - zone.circle(1)) .^ 2 + (py - zone.circle(2)) .^ 2 <= zone.circle(3) ^ 2);
+    end
+end
\ No newline at end of file
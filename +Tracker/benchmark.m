@@ -0,0 +1,168 @@
+function [results, passed] = benchmark(varargin)
+    % [results, passed] = Tracker.benchmark(<name1>, <value1>, ...)
+    % Measure throughput and accuracy of Tracker over synthetic scenes that
+    % span tracking modes, resolutions, ROI sizes, population levels and
+    % thread counts. Results may be saved as JSON and compared against a
+    % stored baseline: a case regresses when its frame rate drops by more
+    % than the tolerance, or when its tracking error grows by more than the
+    % error tolerance (relative, plus 1e-3 normalized units, so that cases
+    % with no error in the baseline do not fail on noise).
+    %
+    % Parameters (name-value pairs):
+    %   Baseline       - JSON file with results from a previous run (default none).
+    %   ErrorTolerance - Relative growth in tracking error tolerated (default 0.25).
+    %   Frames         - Frames per case (default 60).
+    %   Output         - JSON file where results are saved (default none).
+    %   Populations    - Proportion of pixels tested (default [0.02, 0.05, 0.20]).
+    %   Resolutions    - Resolutions [height; width] (default 240x320, 480x640, 1080x1920).
+    %   Rois           - Radius of a circular ROI; 0 for none (default [0, 0.25]).
+    %   Seed           - Seed of the synthetic scenes (default 0).
+    %   Threads        - Computational threads (default [1, maxNumCompThreads]).
+    %   Tolerance      - Relative drop in frame rate tolerated (default 0.10).
+    %
+    % Each case reports the median and 90th percentile time per frame (ms),
+    % the frame rate, and the median tracking error in normalized units
+    % against the ground truth of Camera.Synthetic.
+    %
+    % Cases exercise the stages of the tracking engine through its
+    % settings: thresholding (gray), hue scoring (hue), sampling
+    % (population), erosion (shrink), and labeling and moments (quantity).
+    %
+    % Example:
+    %   Tracker.benchmark('Output', 'baseline.json');
+    %   % ... after a change:
+    %   [~, passed] = Tracker.benchmark('Baseline', 'baseline.json', 'Output', 'latest.json');
+    %
+    % See also Camera.Synthetic, Tracker.
+    
+    % 2026-10-18. Leonardo Molina.
+    % 2026-10-18. Last modified.
+    
+    parser = inputParser();
+    parser.addParameter('Baseline', '');
+    parser.addParameter('ErrorTolerance', 0.25);
+    parser.addParameter('Frames', 60);
+    parser.addParameter('Output', '');
+    parser.addParameter('Populations', [0.02, 0.05, 0.20]);
+    parser.addParameter('Resolutions', [240, 480, 1080; 320, 640, 1920]);
+    parser.addParameter('Rois', [0, 0.25]);
+    parser.addParameter('Seed', 0);
+    parser.addParameter('Threads', unique([1, maxNumCompThreads]));
+    parser.addParameter('Tolerance', 0.10);
+    parser.parse(varargin{:});
+    p = parser.Results;
+    
+    % Tracking modes: name, tracker settings, and scene settings.
+    modes = {
+        'gray',    struct('hue', -2, 'shrink', 0, 'quantity', 1), {'Blobs', 1};
+        'hue',     struct('hue', 0.00, 'shrink', 0, 'quantity', 1), {'Blobs', 1, 'Colors', [1, 0, 0]};
+        'erosion', struct('hue', -2, 'shrink', 3, 'quantity', 1), {'Blobs', 1};
+        'labels',  struct('hue', -2, 'shrink', 0, 'quantity', 4), {'Blobs', 4};
+    };
+    
+    threadsWere = maxNumCompThreads;
+    results = struct('name', {}, 'mode', {}, 'resolution', {}, 'roi', {}, 'population', {}, 'threads', {}, 'median', {}, 'p90', {}, 'fps', {}, 'error', {});
+    for m = 1:size(modes, 1)
+        for r = 1:size(p.Resolutions, 2)
+            for roi = p.Rois
+                for population = p.Populations
+                    for threads = p.Threads
+                        maxNumCompThreads(threads);
+                        resolution = p.Resolutions(:, r);
+                        result = runCase(modes{m, 2}, modes{m, 3}, resolution, roi, population, p.Frames, p.Seed);
+                        result.name = sprintf('%s/%ix%i/roi%.2f/population%.2f/threads%i', modes{m, 1}, resolution(1), resolution(2), roi, population, threads);
+                        result.mode = modes{m, 1};
+                        result.resolution = resolution';
+                        result.roi = roi;
+                        result.population = population;
+                        result.threads = threads;
+                        results(end + 1) = orderfields(result, results); %#ok<AGROW>
+                        fprintf('%-56s %8.2fms %8.1ffps %8.4f\n', result.name, result.median, result.fps, result.error);
+                    end
+                end
+            end
+        end
+    end
+    maxNumCompThreads(threadsWere);
+    
+    if ~isempty(p.Output)
+        fid = fopen(p.Output, 'w');
+        fprintf(fid, '%s', jsonencode(results));
+        fclose(fid);
+    end
+    
+    passed = true;
+    if ~isempty(p.Baseline)
+        baseline = jsondecode(fileread(p.Baseline));
+        [~, i, j] = intersect({results.name}, {baseline.name});
+        for k = 1:numel(i)
+            current = results(i(k)).fps;
+            previous = baseline(j(k)).fps;
+            if current < (1 - p.Tolerance) * previous
+                passed = false;
+                fprintf(2, 'Regression: %s %.1ffps --> %.1ffps (%+.1f%%)\n', results(i(k)).name, previous, current, 100 * (current / previous - 1));
+            end
+            % A case that lost tracking (NaN, saved as null) regresses too.
+            current = results(i(k)).error;
+            previous = baseline(j(k)).error;
+            if isempty(previous)
+                previous = NaN;
+            end
+            if ~(current <= (1 + p.ErrorTolerance) * previous + 1e-3) && ~isnan(previous)
+                passed = false;
+                fprintf(2, 'Regression: %s error %.4f --> %.4f\n', results(i(k)).name, previous, current);
+            end
+        end
+        if passed
+            fprintf('No regressions against %s (%i cases, tolerance %.0f%% in frame rate and %.0f%% in error).\n', p.Baseline, numel(i), 100 * p.Tolerance, 100 * p.ErrorTolerance);
+        end
+    end
+end
+
+function result = runCase(settings, scene, resolution, roi, population, nFrames, seed)
+    % result = runCase(settings, scene, resolution, roi, population, nFrames, seed)
+    % Track nFrames synthetic frames with the given settings.
+    
+    radius = 0.03;
+    camera = Camera.Synthetic(scene{:}, 'Radius', radius, 'Resolutions', resolution, 'Seed', seed);
+    tracker = Tracker();
+    tracker.hue = settings.hue;
+    tracker.shrink = settings.shrink;
+    tracker.quantity = settings.quantity;
+    tracker.population = population;
+    tracker.area = pi * (radius * min(resolution)) ^ 2 / prod(resolution);
+    if roi > 0
+        [xs, ys] = Tools.region([0, 0, roi], 64);
+        tracker.roi = [xs; ys];
+    end
+    
+    % Render first so that only tracking is timed.
+    frames = cell(1, nFrames);
+    for f = 1:nFrames
+        frames{f} = camera.getFrame();
+    end
+    
+    times = zeros(1, nFrames);
+    errors = NaN(1, nFrames);
+    for f = 1:nFrames
+        start = tic;
+        pointers = tracker.track(frames{f});
+        times(f) = toc(start);
+        if ~isempty(pointers)
+            [xs, ys] = Tools.normalize(pointers(1, :), pointers(2, :), resolution(2), resolution(1));
+            d = Tools.distance(camera.truth.X(f, :), camera.truth.Y(f, :), xs, ys);
+            errors(f) = median(sqrt(min(d, [], 2)));
+        end
+    end
+    delete(tracker);
+    
+    % Discard the first frame, which includes one-time initialization.
+    times = sort(times(2:end));
+    result.median = 1e3 * median(times);
+    result.p90 = 1e3 * times(max(1, ceil(0.9 * numel(times))));
+    result.fps = 1 / mean(times);
+    result.error = median(errors(~isnan(errors)));
+    if isempty(result.error)
+        result.error = NaN;
+    end
+end
\ No newline at end of file
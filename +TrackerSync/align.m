@@ -0,0 +1,78 @@
+function [map, fit] = align(reference, other)
+    % [map, fit] = TrackerSync.align(reference, other)
+    % Fit the clock of a device to the clock of a reference device, from the
+    % sync pulses both received (or emitted) through a shared sync line.
+    % reference and other are TrackerSync handles or their syncPulses.
+    %
+    % Pulses are matched by code and by the host time at which they were
+    % received, which is accurate to a small fraction of the sync period.
+    % A line is fitted to the matched device times, once with all pulses
+    % and once more without outliers (e.g. pulses delayed by a busy loop).
+    %
+    % Returns map, a function that converts times (s) from the clock of the
+    % other device to the clock of the reference device, and fit, a struct
+    % with fields:
+    %   Count     - Number of pulses used.
+    %   Drift     - Relative drift between clocks (ppm).
+    %   Offset    - Reference time (s) at the first pulse of the other device.
+    %   Residuals - Residuals (s) of each pulse used.
+    %   Slope     - Reference seconds per second of the other device.
+    %
+    % Example:
+    %   arenas = Arenas({1, 2}, {'COM3', 'COM4'});
+    %   % ... after a few sync periods:
+    %   map = TrackerSync.align(arenas.syncs{1}, arenas.syncs{2});
+    %   referenceTime = map(otherTime);
+    %
+    % See also TrackerSync.
+    
+    % 2026-10-18. Leonardo Molina.
+    % 2026-10-18. Last modified.
+    
+    if isa(reference, 'TrackerSync')
+        reference = reference.syncPulses;
+    end
+    if isa(other, 'TrackerSync')
+        other = other.syncPulses;
+    end
+    
+    % Pulses received within half a period are the same pulse.
+    window = median(diff(reference.HostTime)) / 2;
+    if isnan(window)
+        window = Inf;
+    end
+    nPulses = numel(other.Time);
+    match = NaN(nPulses, 1);
+    for i = 1:nPulses
+        candidates = find(reference.Code == other.Code(i));
+        [delay, k] = min(abs(reference.HostTime(candidates) - other.HostTime(i)));
+        if ~isempty(k) && delay < window
+            match(i) = candidates(k);
+        end
+    end
+    valid = ~isnan(match);
+    if nnz(valid) < 2
+        error('Not enough sync pulses to align devices.');
+    end
+    x = other.Time(valid);
+    y = reference.Time(match(valid));
+    
+    % Center times for numerical precision.
+    x0 = x(1);
+    p = polyfit(x - x0, y, 1);
+    residuals = y - polyval(p, x - x0);
+    inliers = abs(residuals) <= max(5 * median(abs(residuals)), 1e-6);
+    if nnz(inliers) >= 2 && ~all(inliers)
+        x = x(inliers);
+        y = y(inliers);
+        p = polyfit(x - x0, y, 1);
+        residuals = y - polyval(p, x - x0);
+    end
+    
+    map = @(time) p(1) * (time - x0) + p(2);
+    fit.Count = numel(x);
+    fit.Drift = (p(1) - 1) * 1e6;
+    fit.Offset = p(2);
+    fit.Residuals = residuals;
+    fit.Slope = p(1);
+end
\ No newline at end of file
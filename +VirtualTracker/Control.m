@@ -0,0 +1,216 @@
+% VirtualTracker.Control - Control a VirtualTracker.GUI from other processes.
+% Commands are JSON datagrams sent to a UDP port on the loopback interface.
+% While the camera plays, pending commands are applied right after a frame
+% is processed, so that a batch of commands takes effect between two frames
+% and never in the middle of one; otherwise, or when no frame has arrived
+% for longer than stall (s), they are applied by a timer, which also
+% receives commands every period (s) and stamps them.
+% Every command is answered to its sender with a JSON datagram that includes
+% the frame number after which it took effect and the latency (s) between
+% its stamp and its effect, also recorded in Metrics as 'control'. Stamps
+% are taken when a datagram is read from the socket, up to one period after
+% it arrived, so latency understates the delay by as much. The worst case
+% between arrival and effect, period + stall, is reported as "bound" and
+% recorded in Metrics as 'control_bound'; it assumes that no other callback
+% keeps MATLAB busy for longer.
+%
+% Commands (field "command", optional field "id" echoed in the reply):
+%   {"command": "zones", "zones": [{"id": 1, "region": [0, 0, 0.1]}, ...]}
+%       Load a zone schedule (see VirtualTracker.GUI.zones). Entries and
+%       exits are notified to the sender with:
+%       {"event": "zone", "zone": 1, "state": true, "x": 0.01, "y": 0.02}
+%   {"command": "zone", "zone": 2}   - Load the zone with the given index.
+%   {"command": "next"}              - Save trial and load the next zone.
+%   {"command": "discard"}           - Reload the zone without saving.
+%   {"command": "roi", "roi": [x1, y1, x2, y2, ...]}
+%                                    - Set the region of interest.
+%   {"command": "state"}             - Query trial, zone, frame, position,
+%                                      region of interest and play state.
+%
+% Replies:
+%   {"id": 7, "ok": true, "frame": 1234, "latency": 0.0004, "bound": 0.12, ...}
+%   {"id": 7, "ok": false, "error": "..."}
+%
+% Example:
+%   obj = VirtualTracker.GUI();
+%   control = VirtualTracker.Control(obj, 5006);
+%   % From another MATLAB session:
+%   socket = java.net.DatagramSocket();
+%   address = java.net.InetAddress.getByName('127.0.0.1');
+%   command = int8('{"id": 1, "command": "next"}');
+%   socket.send(java.net.DatagramPacket(command, numel(command), address, 5006));
+%   packet = java.net.DatagramPacket(zeros(1, 65536, 'int8'), 65536);
+%   socket.receive(packet);
+%   data = typecast(packet.getData(), 'uint8');
+%   reply = jsondecode(char(data(1:packet.getLength())'));
+%
+% See also VirtualTracker.GUI, VirtualTracker.Stream.
+
+% 2026-10-18. Leonardo Molina.
+% 2026-10-18. Last modified.
+classdef Control < handle
+    properties
+        % stall - Time (s) without frames after which commands are applied by the timer.
+        stall = 0.1
+    end
+    
+    properties (SetAccess = private)
+        % period - Period (s) at which the timer receives commands.
+        period = 0.020
+        
+        % port - Local UDP port.
+        port
+    end
+    
+    properties (Access = private)
+        buffer
+        channel
+        frameHandle
+        frameTime
+        metrics
+        pending = struct('address', {}, 'text', {}, 'start', {})
+        timerHandle
+        virtualTracker
+    end
+    
+    methods
+        function obj = Control(virtualTracker, port)
+            % VirtualTracker.Control(virtualTracker, port)
+            % Accept commands for the given VirtualTracker.GUI on the given
+            % UDP port of the loopback interface.
+            
+            if ~isa(virtualTracker, 'VirtualTracker.GUI')
+                error('Value provided for virtualTracker is invalid.');
+            end
+            obj.virtualTracker = virtualTracker;
+            obj.port = port;
+            obj.channel = java.nio.channels.DatagramChannel.open();
+            obj.channel.configureBlocking(false);
+            obj.channel.socket().bind(java.net.InetSocketAddress('127.0.0.1', port));
+            obj.buffer = java.nio.ByteBuffer.allocate(65536);
+            obj.metrics = Metrics.Instance();
+            obj.frameTime = tic;
+            obj.frameHandle = virtualTracker.camera.register('Frame', @(~)obj.onFrame());
+            obj.timerHandle = Scheduler.Repeat(@obj.onTimer, obj.period);
+        end
+        
+        function delete(obj)
+            % VirtualTracker.Control.delete()
+            % Stop accepting commands and close the socket.
+            
+            Objects.delete(obj.frameHandle, obj.timerHandle);
+            obj.channel.close();
+        end
+    end
+    
+    methods (Access = private)
+        function receive(obj)
+            % VirtualTracker.Control.receive()
+            % Queue incoming commands, stamped with their time of arrival.
+            
+            address = obj.channel.receive(obj.buffer);
+            while ~isempty(address)
+                bytes = obj.buffer.array();
+                text = char(reshape(typecast(bytes(1:obj.buffer.position()), 'uint8'), 1, []));
+                obj.buffer.clear();
+                obj.pending(end + 1) = struct('address', address, 'text', text, 'start', tic);
+                address = obj.channel.receive(obj.buffer);
+            end
+        end
+        
+        function poll(obj)
+            % VirtualTracker.Control.poll()
+            % Apply all pending commands and reply to their senders.
+            
+            obj.receive();
+            pending = obj.pending;
+            obj.pending(:) = [];
+            for p = 1:numel(pending)
+                address = pending(p).address;
+                text = pending(p).text;
+                start = pending(p).start;
+                reply = struct();
+                try
+                    command = jsondecode(text);
+                    if isfield(command, 'id')
+                        reply.id = command.id;
+                    end
+                    reply = obj.execute(command, address, reply);
+                    reply.ok = true;
+                    reply.frame = obj.virtualTracker.camera.frameCount;
+                    reply.latency = toc(start);
+                    reply.bound = obj.period + obj.stall;
+                    obj.metrics.observe('control', reply.latency);
+                    obj.metrics.gauge('control_bound', reply.bound);
+                catch exception
+                    reply.ok = false;
+                    reply.error = exception.message;
+                end
+                obj.send(address, reply);
+            end
+        end
+        
+        function reply = execute(obj, command, address, reply)
+            % reply = VirtualTracker.Control.execute(command, address, reply)
+            % Apply a decoded command.
+            
+            virtualTracker = obj.virtualTracker;
+            switch command.command
+                case 'zones'
+                    entries = command.zones;
+                    if ~iscell(entries)
+                        entries = num2cell(entries);
+                    end
+                    zones = cell(1, 3 * numel(entries));
+                    for k = 1:numel(entries)
+                        id = entries{k}.id;
+                        zones(3 * k - 2:3 * k) = {id, entries{k}.region(:)', @(data)obj.send(address, struct('event', 'zone', 'zone', id, 'state', data.State, 'x', data.X, 'y', data.Y))};
+                    end
+                    virtualTracker.zones = zones;
+                case 'zone'
+                    virtualTracker.zone = command.zone;
+                case 'next'
+                    virtualTracker.next();
+                case 'discard'
+                    virtualTracker.discard();
+                case 'roi'
+                    virtualTracker.roi = command.roi(:)';
+                case 'state'
+                    reply.trial = virtualTracker.trial;
+                    reply.zone = virtualTracker.zone;
+                    reply.position = virtualTracker.position;
+                    reply.roi = virtualTracker.roi;
+                    reply.play = virtualTracker.play;
+                otherwise
+                    error('Value provided for command is invalid.');
+            end
+        end
+        
+        function onFrame(obj)
+            % VirtualTracker.Control.onFrame()
+            % Apply commands between frames.
+            
+            obj.frameTime = tic;
+            obj.poll();
+        end
+        
+        function onTimer(obj)
+            % VirtualTracker.Control.onTimer()
+            % Receive commands, and apply them while no frames are being
+            % processed, either because the camera is stopped or stalled.
+            
+            if ~obj.virtualTracker.play || toc(obj.frameTime) > obj.stall
+                obj.poll();
+            else
+                obj.receive();
+            end
+        end
+        
+        function send(obj, address, message)
+            % VirtualTracker.Control.send(address, message)
+            % Send a JSON message without blocking.
+            
+            obj.channel.send(java.nio.ByteBuffer.wrap(typecast(uint8(jsonencode(message)), 'int8')), address);
+        end
+    end
+end
\ No newline at end of file
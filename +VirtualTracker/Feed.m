@@ -0,0 +1,171 @@
+% VirtualTracker.Feed - Publish positions in shared memory.
+% Positions reported by a VirtualTracker are written to a memory-mapped
+% file that other processes (stimulus renderers, closed-loop controllers)
+% can poll without locks or sockets. On Linux the file is created in
+% /dev/shm (POSIX shared memory); elsewhere it is created in tempdir and
+% shared through the page cache.
+%
+% Layout (little-endian):
+%   Header, 16 x uint32 (64 bytes):
+%     1 magic ('VTPF' = 0x46505456), 2 version (1), 3 capacity (number of
+%     records), 4 record size (48), 5 number of pointers, 6 publish count,
+%     7 to 16 reserved.
+%   Records, one per pointer (48 bytes each):
+%     uint32 seq, uint32 reserved, double time (s), uint64 frame,
+%     double x, double y, uint64 zones (bit r set while inside region r, up
+%     to region 64).
+%
+% Each record is guarded by a seqlock: the writer makes seq odd, writes
+% the fields, then makes seq even. A reader copies a record and accepts it
+% only if seq was even and did not change during the copy; otherwise it
+% retries. Readers never block the writer. In C:
+%   do {
+%       s1 = atomic_load(&record->seq);
+%       copy = *record;
+%       s2 = atomic_load(&record->seq);
+%   } while ((s1 & 1) || s1 != s2);
+%
+% VirtualTracker.Feed methods:
+%   Read - Read all records with the same protocol (MATLAB reader).
+%
+% Example:
+%   obj = VirtualTracker.GUI();
+%   feed = VirtualTracker.Feed(obj, 'virtualtracker');
+%   % From another MATLAB session:
+%   records = VirtualTracker.Feed.Read('virtualtracker');
+%
+% See also VirtualTracker, VirtualTracker.Stream.
+
+% 2026-10-18. Leonardo Molina.
+% 2026-10-18. Last modified.
+classdef Feed < handle
+    properties (Constant)
+        % magic - First word of the header ('VTPF').
+        magic = uint32(hex2dec('46505456'))
+        
+        % version - Layout version.
+        version = uint32(1)
+    end
+    
+    properties (Constant, Access = private)
+        headerSize = 64
+        recordFormat = {'uint32', [1, 1], 'seq'; 'uint32', [1, 1], 'reserved'; 'double', [1, 1], 'time'; 'uint64', [1, 1], 'frame'; 'double', [1, 1], 'x'; 'double', [1, 1], 'y'; 'uint64', [1, 1], 'zones'}
+        recordSize = 48
+    end
+    
+    properties (SetAccess = private)
+        % capacity - Maximum number of pointers published.
+        capacity
+        
+        % filename - Path to the memory-mapped file.
+        filename
+    end
+    
+    properties (Access = private)
+        handle
+        header
+        records
+        sequences
+    end
+    
+    methods
+        function obj = Feed(virtualTracker, name, capacity)
+            % VirtualTracker.Feed(virtualTracker, name, <capacity>)
+            % Publish positions of the given VirtualTracker in a shared
+            % memory segment with the given name, with room for capacity
+            % pointers (default 16).
+            
+            if nargin < 3
+                capacity = 16;
+            end
+            obj.capacity = capacity;
+            obj.filename = VirtualTracker.Feed.path(name);
+            
+            % Allocate the segment.
+            fid = fopen(obj.filename, 'w');
+            fwrite(fid, zeros(1, VirtualTracker.Feed.headerSize + capacity * VirtualTracker.Feed.recordSize, 'uint8'));
+            fclose(fid);
+            obj.header = memmapfile(obj.filename, 'Format', 'uint32', 'Repeat', 16, 'Writable', true);
+            obj.records = memmapfile(obj.filename, 'Offset', VirtualTracker.Feed.headerSize, 'Format', VirtualTracker.Feed.recordFormat, 'Repeat', capacity, 'Writable', true);
+            obj.sequences = zeros(1, capacity);
+            obj.header.Data(2:4) = [VirtualTracker.Feed.version; capacity; VirtualTracker.Feed.recordSize];
+            % Readers check the magic number last.
+            obj.header.Data(1) = VirtualTracker.Feed.magic;
+            
+            obj.handle = virtualTracker.register('Position', @obj.onPosition);
+        end
+        
+        function delete(obj)
+            % VirtualTracker.Feed.delete()
+            % Stop publishing and remove the segment.
+            
+            Objects.delete(obj.handle);
+            obj.header = [];
+            obj.records = [];
+            if exist(obj.filename, 'file') == 2
+                delete(obj.filename);
+            end
+        end
+    end
+    
+    methods (Access = private)
+        function onPosition(obj, data)
+            % VirtualTracker.Feed.onPosition(data)
+            % Write each pointer to its record under the seqlock.
+            
+            n = min(numel(data.X), obj.capacity);
+            for p = 1:n
+                seq = obj.sequences(p);
+                obj.records.Data(p).seq = uint32(mod(seq + 1, 2 ^ 32));
+                obj.records.Data(p).time = data.Time;
+                obj.records.Data(p).frame = uint64(data.Frame);
+                obj.records.Data(p).x = data.X(p);
+                obj.records.Data(p).y = data.Y(p);
+                obj.records.Data(p).zones = uint64(data.Zones(p));
+                obj.records.Data(p).seq = uint32(mod(seq + 2, 2 ^ 32));
+                obj.sequences(p) = mod(seq + 2, 2 ^ 32);
+            end
+            obj.header.Data(5) = uint32(n);
+            obj.header.Data(6) = uint32(mod(double(obj.header.Data(6)) + 1, 2 ^ 32));
+        end
+    end
+    
+    methods (Static)
+        function records = Read(name)
+            % records = VirtualTracker.Feed.Read(name)
+            % Read a consistent copy of every published record.
+            
+            filename = VirtualTracker.Feed.path(name);
+            header = memmapfile(filename, 'Format', 'uint32', 'Repeat', 16);
+            if header.Data(1) ~= VirtualTracker.Feed.magic || header.Data(2) ~= VirtualTracker.Feed.version
+                error('Value provided for name is invalid.');
+            end
+            map = memmapfile(filename, 'Offset', VirtualTracker.Feed.headerSize, 'Format', VirtualTracker.Feed.recordFormat, 'Repeat', header.Data(3));
+            n = header.Data(5);
+            records = map.Data(1:n);
+            for p = 1:n
+                stable = false;
+                while ~stable
+                    seq1 = map.Data(p).seq;
+                    record = map.Data(p);
+                    seq2 = map.Data(p).seq;
+                    stable = mod(seq1, 2) == 0 && seq1 == seq2;
+                end
+                records(p) = record;
+            end
+        end
+    end
+    
+    methods (Static, Access = private)
+        function filename = path(name)
+            % filename = VirtualTracker.Feed.path(name)
+            % Location of the segment with the given name.
+            
+            if exist('/dev/shm', 'dir') == 7
+                filename = fullfile('/dev/shm', name);
+            else
+                filename = fullfile(tempdir, name);
+            end
+        end
+    end
+end
\ No newline at end of file
@@ -21,11 +21,33 @@
 %            9, [+0.0, +0.0, +0.0], @(data)fprintf('zone 9: %i\n', data.State)};
 %   obj = VirtualTracker.GUI();
 %   obj.zones = zones;
+% 
+% VirtualTracker.GUI methods:
+%   discard - Reload current zone without saving (Discard trial button).
+%   next    - Save current trial and load the next zone (Next trial button).
+% 
+% VirtualTracker.GUI events:
+%   Discard()    - Trial was discarded.
+%   Next()       - Trial was saved and the next zone was loaded.
+%   Zones(zones) - Zones were configured.
+
+% Rendering is decoupled from acquisition: frames and positions are only
+% buffered as they arrive, and the playback window is refreshed at a fixed
+% rate (refreshRate) with a downscaled preview of the last frame (previewSize).
+% Blob pixels are sampled on the same preview grid and outlined by their
+% bounding boxes.
 
 % 2018-05-30. Leonardo Molina.
-% 2018-07-16. Last modified.
+% 2026-10-18. Last modified.
 classdef GUI < VirtualTracker
     properties (Dependent)
+        % refreshRate - Rate (Hz) at which the playback window is redrawn.
+        refreshRate
+        
+        % trail - Length of trail left by a pointer. Trails are ring buffers,
+        % so long trails (e.g. a whole trial) add no cost per frame.
+        trail
+        
         % zone - Index of current target zone.
         zone
         
@@ -34,8 +56,8 @@ classdef GUI < VirtualTracker
     end
     
     properties
-        % trail - Length of trail left by a pointer.
-        trail = 20
+        % previewSize - Maximum size (pixels) of the largest dimension of the preview image.
+        previewSize = 320
     end
     
     properties (SetAccess = private, Hidden)
@@ -50,11 +72,20 @@ classdef GUI < VirtualTracker
         
         % Lines.
         blobLines
+        boxLines
         pathLines = {}
         pointerLines = {}
         roiLine
         targetLines = {}
         
+        % Rendering.
+        frameChanged = false
+        paths = {}
+        positionChanged = false
+        refreshHandle
+        mRefreshRate = 30
+        mTrail = 20
+        
         % Other.
         caret = 1
         roiChanging = false
@@ -83,8 +114,8 @@ classdef GUI < VirtualTracker
             panel = uipanel('Title', 'VirtualTracker');
             panel.Units = 'Pixels';
             panel.Position = [1, 1, width, nRows * height];
-            obj.discardButton = uicontrol('Parent', panel, 'Style', 'PushButton', 'Position', [0.20 * width, 0 * height, 0.40 * width, height], 'Units', 'Normalized', 'String', 'Discard trial', 'Callback', @(~, ~)obj.onDiscardButton);
-            obj.nextButton    = uicontrol('Parent', panel, 'Style', 'PushButton', 'Position', [0.60 * width, 0 * height, 0.40 * width, height], 'Units', 'Normalized', 'String', 'Next trial', 'Callback', @(~, ~)obj.onNextButton);
+            obj.discardButton = uicontrol('Parent', panel, 'Style', 'PushButton', 'Position', [0.20 * width, 0 * height, 0.40 * width, height], 'Units', 'Normalized', 'String', 'Discard trial', 'Callback', @(~, ~)obj.discard);
+            obj.nextButton    = uicontrol('Parent', panel, 'Style', 'PushButton', 'Position', [0.60 * width, 0 * height, 0.40 * width, height], 'Units', 'Normalized', 'String', 'Next trial', 'Callback', @(~, ~)obj.next);
             obj.pushPanel(panel);
             
             % Add Tracker controls.
@@ -105,6 +136,7 @@ classdef GUI < VirtualTracker
             % Add lines.
             obj.roiLine = obj.playback.line('LineStyle', '--', 'Marker', 'none', 'Color', [1, 1, 1]);
             obj.blobLines = obj.playback.line('LineStyle', 'none', 'Marker', '+', 'MarkerSize', 1, 'LineWidth', 1, 'Color', [0, 0, 1]);
+            obj.boxLines = obj.playback.line('LineStyle', ':', 'Marker', 'none', 'LineWidth', 1, 'Color', [0, 0, 1]);
             
             % Listen to property changes.
             obj.register('Position', @obj.onPosition);
@@ -113,6 +145,27 @@ classdef GUI < VirtualTracker
             
             % Initialize superclass.
             obj.initialize(tracker, camera);
+            
+            % Redraw at a fixed rate, regardless of the camera's frame rate.
+            obj.refreshHandle = Scheduler.Repeat(@obj.onRefresh, 1 / obj.refreshRate);
+        end
+        
+        function discard(obj)
+            % VirtualTracker.GUI.discard()
+            % Reload zone without saving.
+            
+            obj.clearLines();
+            obj.zone = obj.zone;
+            obj.invoke('Discard');
+        end
+        
+        function next(obj)
+            % VirtualTracker.GUI.next()
+            % Save current trial and load next zone.
+            
+            obj.save();
+            obj.zone = obj.zone + 1;
+            obj.invoke('Next');
         end
         
         function pushPanel(obj, panel)
@@ -130,11 +183,38 @@ classdef GUI < VirtualTracker
             % VirtualTracker.GUI.delete()
             % Close window figure and release resources.
             
+            delete(obj.refreshHandle);
             delete(obj.playback);
             delete(obj.window);
             delete@VirtualTracker(obj);
         end
         
+        function rate = get.refreshRate(obj)
+            rate = obj.mRefreshRate;
+        end
+        
+        function set.refreshRate(obj, rate)
+            if isnumeric(rate) && isscalar(rate) && rate > 0
+                obj.mRefreshRate = rate;
+                delete(obj.refreshHandle);
+                obj.refreshHandle = Scheduler.Repeat(@obj.onRefresh, 1 / rate);
+            else
+                error('Value provided for refreshRate is invalid.');
+            end
+        end
+        
+        function trail = get.trail(obj)
+            trail = obj.mTrail;
+        end
+        
+        function set.trail(obj, trail)
+            if isnumeric(trail) && isscalar(trail) && trail >= 1 && trail == round(trail) && isfinite(trail)
+                obj.mTrail = trail;
+            else
+                error('Value provided for trail is invalid.');
+            end
+        end
+        
         function zones = get.zones(obj)
             zones = obj.mZones;
         end
@@ -148,6 +228,7 @@ classdef GUI < VirtualTracker
             obj.mZones = zones;
             
             obj.zone = 1;
+            obj.invoke('Zones', zones);
         end
         
         function zone = get.zone(obj)
@@ -187,27 +268,11 @@ classdef GUI < VirtualTracker
             delete(obj);
         end
         
-        function onDiscardButton(obj)
-            % VirtualTracker.GUI.onDiscardButton()
-            % Reload zone without saving.
-            
-            obj.clearLines();
-            obj.zone = obj.zone;
-        end
-        
         function onFrame(obj)
             % VirtualTracker.GUI.onFrame()
-            % New image reported by camera.
+            % New image reported by camera. Rendering is deferred to onRefresh.
             
-            obj.playback.image = obj.camera.frame;
-        end
-        
-        function onNextButton(obj)
-            % VirtualTracker.GUI.onNextButton()
-            % Save current trial and load next zone.
-            
-            obj.save();
-            obj.zone = obj.zone + 1;
+            obj.frameChanged = true;
         end
         
         function clearLines(obj)
@@ -220,6 +285,7 @@ classdef GUI < VirtualTracker
             obj.pointerLines = {};
             obj.pathLines = {};
             obj.targetLines = {};
+            obj.paths = {};
         end
         
         function onKeyPress(obj, data)
@@ -243,24 +309,75 @@ classdef GUI < VirtualTracker
         
         function onPosition(obj, data)
             % VirtualTracker.GUI.onPosition()
-            % Tracker reports a change in position. Update graphics.
+            % Tracker reports a change in position. Buffer trails; graphics
+            % are updated in onRefresh.
             
-            nLines = numel(obj.pointerLines);
             nPoints = numel(data.X);
-            for p = nLines + 1:nPoints
-                obj.pointerLines{p} = obj.playback.line('LineStyle', 'none', 'Marker', 'o', 'MarkerSize', 10, 'LineWidth', 3);
-                obj.pathLines{p} = obj.playback.line('LineStyle', '-', 'Marker', 'none', 'Color', obj.pointerLines{p}.handle.Color, 'LineWidth', 1);
-            end
             for p = 1:nPoints
-                current = [data.X(p); data.Y(p)];
-                obj.pathLines{p}.data = [obj.pathLines{p}.data; current];
-                obj.pathLines{p}.data = obj.pathLines{p}.data(end + 1 - min(2 * obj.trail, numel(obj.pathLines{p}.data)):end);
-                obj.pathLines{p}.data = obj.pathLines{p}.data(end + 1 - min(2 * obj.trail, numel(obj.pathLines{p}.data)):end);
-                obj.pointerLines{p}.data = current;
+                if p > numel(obj.paths) || obj.paths{p}.capacity ~= obj.trail
+                    obj.paths{p} = Ring(obj.trail, 2);
+                end
+                obj.paths{p}.push([data.X(p); data.Y(p)]);
+            end
+            obj.positionChanged = true;
+        end
+        
+        function onRefresh(obj)
+            % VirtualTracker.GUI.onRefresh()
+            % Draw the last frame and overlays at most once per refresh
+            % period, regardless of how many frames arrived in between.
+            
+            if obj.frameChanged
+                obj.frameChanged = false;
+                frame = obj.camera.frame;
+                step = max(1, ceil(max(size(frame, 1), size(frame, 2)) / obj.previewSize));
+                obj.playback.image = frame(1:step:end, 1:step:end, :);
+            end
+            
+            if obj.positionChanged
+                obj.positionChanged = false;
+                nLines = numel(obj.pointerLines);
+                nPoints = numel(obj.paths);
+                for p = nLines + 1:nPoints
+                    obj.pointerLines{p} = obj.playback.line('LineStyle', 'none', 'Marker', 'o', 'MarkerSize', 10, 'LineWidth', 3);
+                    obj.pathLines{p} = obj.playback.line('LineStyle', '-', 'Marker', 'none', 'Color', obj.pointerLines{p}.handle.Color, 'LineWidth', 1);
+                end
+                for p = 1:nPoints
+                    obj.pathLines{p}.data = obj.paths{p}.data;
+                    obj.pointerLines{p}.data = obj.paths{p}.last;
+                end
+                obj.drawBlobs();
+            end
+        end
+        
+        function drawBlobs(obj)
+            % VirtualTracker.GUI.drawBlobs()
+            % Overlay blob pixels sampled on the preview grid, and a bounding
+            % box around each blob. The cost is proportional to the preview
+            % size rather than to the camera resolution.
+            
+            blobs = obj.tracker.blobs;
+            step = max(1, ceil(max(size(blobs, 1), size(blobs, 2)) / obj.previewSize));
+            sample = blobs(1:step:end, 1:step:end);
+            [is, js] = find(sample);
+            [xs, ys] = Tools.normalize((js - 1) * step + 1, (is - 1) * step + 1, obj.camera.resolution(2), obj.camera.resolution(1));
+            obj.blobLines.data = [xs, ys]';
+            
+            if isempty(xs)
+                obj.boxLines.data = [];
+            else
+                % Blobs are told apart by their identity; a binary mask is one blob.
+                [~, ~, ids] = unique(sample(sub2ind(size(sample), is, js)));
+                x1 = accumarray(ids, xs, [], @min);
+                x2 = accumarray(ids, xs, [], @max);
+                y1 = accumarray(ids, ys, [], @min);
+                y2 = accumarray(ids, ys, [], @max);
+                % One closed rectangle per blob, separated by NaN.
+                nans = NaN(size(x1));
+                bx = [x1, x2, x2, x1, x1, nans]';
+                by = [y1, y1, y2, y2, y1, nans]';
+                obj.boxLines.data = [bx(:), by(:)]';
             end
-            [ys, xs] = find(obj.tracker.blobs);
-            [xs, ys] = Tools.normalize(xs, ys, obj.camera.resolution(2), obj.camera.resolution(1));
-            obj.blobLines.data = [xs ys]';
         end
         
         function onRoi(obj, roi)
@@ -0,0 +1,182 @@
+% VirtualTracker.Recorder - Record the complete input of a session.
+% Capture every frame seen by the tracker (optionally downsampled), serial
+% data received by TrackerSync, and user actions (next and discard trial,
+% ROI edits, zone configuration, tracker and camera settings), each tagged
+% with the time and the number of frames processed when it happened.
+% A recording may be replayed deterministically with VirtualTracker.Replayer.
+%
+% Actions are stored with columns frame, time, target, name and value:
+%   target  name                                     value
+%   tracker area, hue, population, quantity, shrink  Setting value.
+%   camera  exposure, mirror, resolution             Setting value.
+%   gui     roi, zones, zone, next, discard          Region, zones, index or [].
+% Zones are recorded without their callbacks (each replaced by []), which
+% may hold handles to hardware, sockets or figures of the session.
+%   serial  bytes                                    uint8 data.
+% The initial state of the session is recorded as actions at frame 0.
+%
+% VirtualTracker.Recorder methods:
+%   save - Save recording to a MAT file.
+%   stop - Stop recording.
+%   Load - Load a recording from a MAT file.
+%
+% Example:
+%   sync = TrackerSync('COM3');
+%   recorder = VirtualTracker.Recorder(sync, 2);
+%   % ... run the session.
+%   recorder.save('session.mat');
+%   % ... later, replay as fast as possible:
+%   replayer = VirtualTracker.Replayer('session.mat', Inf);
+%   replayer.start();
+%
+% Frames are kept in memory until saved: a 640x480 session at 30 Hz takes
+% about 1.6GB per minute at scale 1, and four times less at scale 2.
+%
+% See also VirtualTracker.Replayer, Camera.Replay.
+
+% 2026-10-18. Leonardo Molina.
+% 2026-10-18. Last modified.
+classdef Recorder < handle
+    properties (SetAccess = private)
+        % recording - Recorded session.
+        recording
+        
+        % scale - Downsampling factor of recorded frames.
+        scale
+    end
+    
+    properties (Access = private)
+        camera
+        handles = {}
+        startFrame
+        startTime
+    end
+    
+    methods
+        function obj = Recorder(target, scale)
+            % VirtualTracker.Recorder(target, <scale>)
+            % Record the session of a VirtualTracker or TrackerSync object.
+            % Frames are downsampled by the given integer factor (default 1).
+            
+            if nargin < 2
+                scale = 1;
+            end
+            if isa(target, 'TrackerSync')
+                sync = target;
+                virtualTracker = sync.virtualTracker;
+            elseif isa(target, 'VirtualTracker')
+                sync = [];
+                virtualTracker = target;
+            else
+                error('Value provided for target is invalid.');
+            end
+            obj.scale = scale;
+            obj.camera = virtualTracker.camera;
+            obj.recording = struct( ...
+                'frames', {cell(1, 0)}, ...
+                'frameTimes', zeros(1, 0), ...
+                'actions', struct('frame', {}, 'time', {}, 'target', {}, 'name', {}, 'value', {}), ...
+                'exposureRange', obj.camera.exposureRange, ...
+                'scale', scale, ...
+                'sync', ~isempty(sync));
+            obj.startFrame = obj.camera.frameCount;
+            obj.startTime = tic;
+            
+            % Initial state.
+            tracker = virtualTracker.tracker;
+            settings = {'area', 'hue', 'population', 'quantity', 'shrink'};
+            for s = 1:numel(settings)
+                obj.add('tracker', settings{s}, tracker.(settings{s}));
+            end
+            cameraSettings = {'exposure', 'mirror', 'resolution'};
+            for s = 1:numel(cameraSettings)
+                obj.add('camera', cameraSettings{s}, obj.camera.(cameraSettings{s}));
+            end
+            obj.add('gui', 'roi', virtualTracker.roi);
+            isGUI = isa(virtualTracker, 'VirtualTracker.GUI');
+            if isGUI && ~isempty(virtualTracker.zones)
+                obj.add('gui', 'zones', VirtualTracker.Recorder.strip(virtualTracker.zones));
+                obj.add('gui', 'zone', virtualTracker.zone);
+            end
+            
+            % Changes.
+            obj.handles{end + 1} = obj.camera.register('Frame', @obj.onFrame);
+            obj.handles{end + 1} = obj.camera.register('Exposure', @()obj.add('camera', 'exposure', obj.camera.exposure));
+            obj.handles{end + 1} = obj.camera.register('Mirror', @()obj.add('camera', 'mirror', obj.camera.mirror));
+            obj.handles{end + 1} = obj.camera.register('Resolution', @(~)obj.add('camera', 'resolution', obj.camera.resolution));
+            obj.handles{end + 1} = virtualTracker.register('Roi', @(roi)obj.add('gui', 'roi', roi));
+            for s = 1:numel(settings)
+                name = settings{s};
+                obj.handles{end + 1} = tracker.register([upper(name(1)), name(2:end)], @(value)obj.add('tracker', name, value));
+            end
+            if isGUI
+                obj.handles{end + 1} = virtualTracker.register('Zones', @(zones)obj.add('gui', 'zones', VirtualTracker.Recorder.strip(zones)));
+                obj.handles{end + 1} = virtualTracker.register('Next', @()obj.add('gui', 'next', []));
+                obj.handles{end + 1} = virtualTracker.register('Discard', @()obj.add('gui', 'discard', []));
+            end
+            if ~isempty(sync)
+                obj.handles{end + 1} = sync.register('Serial', @(bytes)obj.add('serial', 'bytes', uint8(bytes)));
+            end
+        end
+        
+        function delete(obj)
+            % VirtualTracker.Recorder.delete()
+            % Stop recording.
+            
+            obj.stop();
+        end
+        
+        function stop(obj)
+            % VirtualTracker.Recorder.stop()
+            % Stop recording; data recorded so far is kept.
+            
+            Objects.delete(obj.handles{:});
+            obj.handles = {};
+        end
+        
+        function save(obj, filename)
+            % VirtualTracker.Recorder.save(filename)
+            % Save the recording to a MAT file.
+            
+            recording = obj.recording; %#ok<NASGU>
+            save(filename, 'recording', '-v7.3');
+        end
+    end
+    
+    methods (Access = private)
+        function add(obj, target, name, value)
+            % VirtualTracker.Recorder.add(target, name, value)
+            % Append an action, tagged with the number of frames processed.
+            
+            frame = obj.camera.frameCount - obj.startFrame;
+            obj.recording.actions(end + 1) = struct('frame', frame, 'time', toc(obj.startTime), 'target', target, 'name', name, 'value', {value});
+        end
+        
+        function onFrame(obj, frame)
+            % VirtualTracker.Recorder.onFrame(frame)
+            % Append a frame, downsampled by scale.
+            
+            obj.recording.frames{end + 1} = frame(1:obj.scale:end, 1:obj.scale:end, :);
+            obj.recording.frameTimes(end + 1) = toc(obj.startTime);
+        end
+    end
+    
+    methods (Static)
+        function recording = Load(filename)
+            % recording = VirtualTracker.Recorder.Load(filename)
+            % Load a recording saved with VirtualTracker.Recorder.save.
+            
+            c = load(filename);
+            recording = c.recording;
+        end
+    end
+    
+    methods (Static, Access = private)
+        function zones = strip(zones)
+            % zones = VirtualTracker.Recorder.strip(zones)
+            % Zone ids and regions, without callbacks.
+            
+            zones(3:3:end) = {[]};
+        end
+    end
+end
\ No newline at end of file
@@ -0,0 +1,178 @@
+% VirtualTracker.Replayer - Replay a recorded session through the pipeline.
+% Recorded frames are fed to a new VirtualTracker.GUI (or TrackerSync, when
+% serial data was recorded) through a Camera.Replay backend. Actions are
+% applied right after the frame that preceded them in the recording, so
+% that the sequence of frames, settings, zone changes and serial data seen
+% by the pipeline is the same regardless of the playback speed.
+%
+% Camera settings are restored from the recording, except for mirror and
+% resolution, which are already applied to the recorded frames. Settings
+% saved by TrackerSync are neither applied to the replay nor overwritten.
+% Zones are recorded without callbacks, so that a replay has none of the
+% side effects of the session (e.g. rewards); changes of state are reported
+% with the Zone event instead.
+%
+% At speed 1 frames are delivered at the pace they were recorded, from the
+% camera's own loop. At speed Inf, start blocks and feeds frames as fast as
+% the pipeline consumes them, which is useful for profiling with Trace and
+% Metrics.
+%
+% VirtualTracker.Replayer methods:
+%   start - Start the replay.
+%
+% VirtualTracker.Replayer properties:
+%   elapsed        - Duration (s) of the replay once it ended.
+%   sync           - TrackerSync handle, if serial data was recorded.
+%   virtualTracker - VirtualTracker.GUI handle.
+%
+% VirtualTracker.Replayer events:
+%   End()          - All frames and actions were replayed.
+%   Zone(id, data) - A zone changed state; data is as given to zone callbacks.
+%
+% Example:
+%   replayer = VirtualTracker.Replayer('session.mat', Inf);
+%   replayer.start();
+%   fprintf('Replayed in %.2fs\n', replayer.elapsed);
+%
+% See also VirtualTracker.Recorder, Camera.Replay.
+
+% 2026-10-18. Leonardo Molina.
+% 2026-10-18. Last modified.
+classdef Replayer < Event
+    properties (SetAccess = private)
+        % elapsed - Duration (s) of the replay once it ended.
+        elapsed = NaN
+        
+        % sync - TrackerSync handle, if serial data was recorded.
+        sync
+        
+        % virtualTracker - VirtualTracker.GUI handle.
+        virtualTracker
+    end
+    
+    properties (Access = private)
+        actions
+        backend
+        frameHandle
+        nFrames
+        next = 1
+        startTime
+    end
+    
+    methods
+        function obj = Replayer(recording, speed)
+            % VirtualTracker.Replayer(recording, <speed>)
+            % Prepare the replay of a recording (a struct or a MAT file
+            % saved by VirtualTracker.Recorder) at the given speed (default 1).
+            
+            if nargin < 2
+                speed = 1;
+            end
+            if ischar(recording)
+                recording = VirtualTracker.Recorder.Load(recording);
+            end
+            obj.backend = Camera.Replay(recording, speed);
+            if recording.sync
+                % Settings of the rig are neither applied to nor overwritten by the replay.
+                obj.sync = TrackerSync('', obj.backend, '');
+                obj.virtualTracker = obj.sync.virtualTracker;
+            else
+                obj.virtualTracker = VirtualTracker.GUI(obj.backend);
+            end
+            obj.actions = recording.actions;
+            obj.nFrames = numel(recording.frames);
+            
+            % Restore the initial state.
+            obj.apply(0);
+            obj.frameHandle = obj.virtualTracker.camera.register('Frame', @(~)obj.onFrame);
+        end
+        
+        function delete(obj)
+            % VirtualTracker.Replayer.delete()
+            % Stop the replay and close the pipeline.
+            
+            Objects.delete(obj.frameHandle);
+            if isempty(obj.sync)
+                Objects.delete(obj.virtualTracker);
+            else
+                Objects.delete(obj.sync);
+            end
+        end
+        
+        function start(obj)
+            % VirtualTracker.Replayer.start()
+            % Start the replay. At maximum speed, return when it ends.
+            
+            obj.startTime = tic;
+            if isinf(obj.backend.speed)
+                camera = obj.virtualTracker.camera;
+                while obj.backend.hasFrame
+                    camera.getFrame();
+                    % Let timers (e.g. rendering) run.
+                    drawnow('limitrate');
+                end
+            else
+                obj.virtualTracker.play = true;
+            end
+        end
+    end
+    
+    methods (Access = private)
+        function apply(obj, frame)
+            % VirtualTracker.Replayer.apply(frame)
+            % Apply pending actions recorded up to the given frame.
+            
+            while obj.next <= numel(obj.actions) && obj.actions(obj.next).frame <= frame
+                action = obj.actions(obj.next);
+                obj.next = obj.next + 1;
+                switch action.target
+                    case 'tracker'
+                        obj.virtualTracker.tracker.(action.name) = action.value;
+                    case 'camera'
+                        % Recorded frames are already mirrored and scaled.
+                        if ~ismember(action.name, {'mirror', 'resolution'})
+                            obj.virtualTracker.camera.(action.name) = action.value;
+                        end
+                    case 'gui'
+                        switch action.name
+                            case 'next'
+                                obj.virtualTracker.next();
+                            case 'discard'
+                                obj.virtualTracker.discard();
+                            case 'zones'
+                                obj.virtualTracker.zones = obj.inert(action.value);
+                            otherwise
+                                obj.virtualTracker.(action.name) = action.value;
+                        end
+                    case 'serial'
+                        obj.sync.ingest(action.value);
+                end
+            end
+        end
+        
+        function zones = inert(obj, zones)
+            % zones = VirtualTracker.Replayer.inert(zones)
+            % Give recorded zones callbacks that only report changes.
+            
+            for z = 1:3:numel(zones)
+                id = zones{z};
+                zones{z + 2} = @(data)obj.invoke('Zone', id, data);
+            end
+        end
+        
+        function onFrame(obj)
+            % VirtualTracker.Replayer.onFrame()
+            % A recorded frame went through the pipeline: apply the actions
+            % that followed it.
+            
+            frame = obj.virtualTracker.camera.frameCount;
+            obj.apply(frame);
+            if frame == obj.nFrames
+                obj.apply(Inf);
+                obj.virtualTracker.play = false;
+                obj.elapsed = toc(obj.startTime);
+                obj.invoke('End');
+            end
+        end
+    end
+end
\ No newline at end of file
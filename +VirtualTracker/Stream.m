@@ -0,0 +1,231 @@
+% VirtualTracker.Stream - Stream positions and zone events over loopback UDP.
+% Records are queued as positions are reported and sent in batches, either
+% when enough records are queued or periodically, to every subscriber.
+% The socket is non-blocking: a subscriber that does not keep up loses
+% datagrams (detected with sequence numbers) but never delays tracking.
+%
+% Subscribers announce themselves by sending a one-byte datagram to the
+% stream's port: 'S' to subscribe and 'U' to unsubscribe. Datagrams are sent
+% back to the address the announcement came from.
+%
+% Datagram layout (little-endian):
+%   Header (16 bytes): uint32 magic ('VTST' = 0x54535456), uint32 sequence,
+%   uint16 number of records, uint16 version (1), uint32 reserved.
+%   Records (24 bytes each): uint8 type (1: position, 2: zone entry,
+%   3: zone exit), uint8 pointer, uint16 zone, uint32 frame, double time (s),
+%   single x, single y.
+%
+% VirtualTracker.Stream methods:
+%   flush  - Send queued records now.
+%   Decode - Decode a datagram (MATLAB subscriber).
+%
+% VirtualTracker.Stream properties:
+%   batchCount  - Send as soon as this many records are queued.
+%   batchPeriod - Send queued records at least this often (s).
+%   port        - Local UDP port.
+%   subscribers - Number of subscribers.
+%
+% Example:
+%   obj = VirtualTracker.GUI();
+%   stream = VirtualTracker.Stream(obj, 5005);
+%   % From another MATLAB session:
+%   socket = java.net.DatagramSocket();
+%   address = java.net.InetAddress.getByName('127.0.0.1');
+%   socket.send(java.net.DatagramPacket(int8('S'), 1, address, 5005));
+%   packet = java.net.DatagramPacket(zeros(1, 65536, 'int8'), 65536);
+%   socket.receive(packet);
+%   data = VirtualTracker.Stream.Decode(typecast(packet.getData(), 'uint8'));
+%
+% See also VirtualTracker, VirtualTracker.Feed.
+
+% 2026-10-18. Leonardo Molina.
+% 2026-10-18. Last modified.
+classdef Stream < handle
+    properties (Constant)
+        % magic - First word of every datagram ('VTST').
+        magic = uint32(hex2dec('54535456'))
+        
+        % version - Layout version.
+        version = uint16(1)
+    end
+    
+    properties (Constant, Access = private)
+        headerSize = 16
+        recordSize = 24
+        % Records per datagram; keeps datagrams under 1500 bytes.
+        maxRecords = 60
+    end
+    
+    properties
+        % batchCount - Send as soon as this many records are queued.
+        batchCount = 16
+    end
+    
+    properties (Dependent)
+        % batchPeriod - Send queued records at least this often (s).
+        batchPeriod
+        
+        % subscribers - Number of subscribers.
+        subscribers
+    end
+    
+    properties (SetAccess = private)
+        % port - Local UDP port.
+        port
+    end
+    
+    properties (Access = private)
+        addresses = {}
+        buffer
+        channel
+        handle
+        metrics
+        mBatchPeriod = 0.010
+        previous = zeros(1, 0)
+        queue = zeros(0, 24, 'uint8')
+        sequence = 0
+        timerHandle
+    end
+    
+    methods
+        function obj = Stream(virtualTracker, port)
+            % VirtualTracker.Stream(virtualTracker, port)
+            % Stream positions and zone events of the given VirtualTracker
+            % from the given UDP port on the loopback interface.
+            
+            obj.port = port;
+            obj.channel = java.nio.channels.DatagramChannel.open();
+            obj.channel.configureBlocking(false);
+            obj.channel.socket().bind(java.net.InetSocketAddress('127.0.0.1', port));
+            obj.buffer = java.nio.ByteBuffer.allocate(16);
+            obj.metrics = Metrics.Instance();
+            obj.handle = virtualTracker.register('Position', @obj.onPosition);
+            obj.timerHandle = Scheduler.Repeat(@obj.onTimer, obj.batchPeriod);
+        end
+        
+        function delete(obj)
+            % VirtualTracker.Stream.delete()
+            % Stop streaming and close the socket.
+            
+            Objects.delete(obj.handle, obj.timerHandle);
+            obj.channel.close();
+        end
+        
+        function flush(obj)
+            % VirtualTracker.Stream.flush()
+            % Send queued records to every subscriber without blocking.
+            
+            while size(obj.queue, 1) > 0
+                n = min(size(obj.queue, 1), VirtualTracker.Stream.maxRecords);
+                obj.sequence = mod(obj.sequence + 1, 2 ^ 32);
+                header = [typecast(VirtualTracker.Stream.magic, 'uint8'), typecast(uint32(obj.sequence), 'uint8'), typecast(uint16(n), 'uint8'), typecast(VirtualTracker.Stream.version, 'uint8'), zeros(1, 4, 'uint8')];
+                body = obj.queue(1:n, :)';
+                obj.queue(1:n, :) = [];
+                datagram = typecast([header, body(:)'], 'int8');
+                for s = 1:numel(obj.addresses)
+                    % A full socket buffer returns 0 bytes sent: drop the datagram.
+                    sent = obj.channel.send(java.nio.ByteBuffer.wrap(datagram), obj.addresses{s});
+                    if sent == 0
+                        obj.metrics.count('stream_dropped');
+                    else
+                        obj.metrics.count('stream_datagrams');
+                    end
+                end
+            end
+        end
+        
+        function period = get.batchPeriod(obj)
+            period = obj.mBatchPeriod;
+        end
+        
+        function set.batchPeriod(obj, period)
+            if isnumeric(period) && isscalar(period) && period > 0
+                obj.mBatchPeriod = period;
+                Objects.delete(obj.timerHandle);
+                obj.timerHandle = Scheduler.Repeat(@obj.onTimer, period);
+            else
+                error('Value provided for batchPeriod is invalid.');
+            end
+        end
+        
+        function n = get.subscribers(obj)
+            n = numel(obj.addresses);
+        end
+    end
+    
+    methods (Access = private)
+        function onPosition(obj, data)
+            % VirtualTracker.Stream.onPosition(data)
+            % Queue one position record per pointer, and one record per
+            % zone entered or exited.
+            
+            nPointers = numel(data.X);
+            previous = zeros(1, nPointers, 'uint64');
+            n = min(nPointers, numel(obj.previous));
+            previous(1:n) = obj.previous(1:n);
+            for p = 1:nPointers
+                obj.queue(end + 1, :) = VirtualTracker.Stream.record(1, p, 0, data.Frame, data.Time, data.X(p), data.Y(p));
+                changed = find(bitget(bitxor(previous(p), uint64(data.Zones(p))), 1:64));
+                for zone = changed
+                    type = 3 - bitget(uint64(data.Zones(p)), zone);
+                    obj.queue(end + 1, :) = VirtualTracker.Stream.record(type, p, zone, data.Frame, data.Time, data.X(p), data.Y(p));
+                end
+            end
+            obj.previous = data.Zones;
+            if size(obj.queue, 1) >= obj.batchCount
+                obj.flush();
+            end
+        end
+        
+        function onTimer(obj)
+            % VirtualTracker.Stream.onTimer()
+            % Register (un)subscriptions and send pending records.
+            
+            address = obj.channel.receive(obj.buffer);
+            while ~isempty(address)
+                command = obj.buffer.get(0);
+                obj.buffer.clear();
+                k = find(cellfun(@(other) other.equals(address), obj.addresses), 1);
+                if command == int8('S') && isempty(k)
+                    obj.addresses{end + 1} = address;
+                elseif command == int8('U') && ~isempty(k)
+                    obj.addresses(k) = [];
+                end
+                address = obj.channel.receive(obj.buffer);
+            end
+            obj.flush();
+        end
+    end
+    
+    methods (Static)
+        function data = Decode(bytes)
+            % data = VirtualTracker.Stream.Decode(bytes)
+            % Decode a datagram into a struct with fields Sequence, Type,
+            % Pointer, Zone, Frame, Time, X and Y (one element per record).
+            
+            bytes = uint8(bytes(:)');
+            if numel(bytes) < VirtualTracker.Stream.headerSize || typecast(bytes(1:4), 'uint32') ~= VirtualTracker.Stream.magic
+                error('Value provided for bytes is invalid.');
+            end
+            n = double(typecast(bytes(9:10), 'uint16'));
+            records = reshape(bytes(VirtualTracker.Stream.headerSize + 1:VirtualTracker.Stream.headerSize + n * VirtualTracker.Stream.recordSize), VirtualTracker.Stream.recordSize, n);
+            data.Sequence = double(typecast(bytes(5:8), 'uint32'));
+            data.Type = double(records(1, :));
+            data.Pointer = double(records(2, :));
+            data.Zone = double(typecast(reshape(records(3:4, :), 1, []), 'uint16'));
+            data.Frame = double(typecast(reshape(records(5:8, :), 1, []), 'uint32'));
+            data.Time = typecast(reshape(records(9:16, :), 1, []), 'double');
+            data.X = double(typecast(reshape(records(17:20, :), 1, []), 'single'));
+            data.Y = double(typecast(reshape(records(21:24, :), 1, []), 'single'));
+        end
+    end
+    
+    methods (Static, Access = private)
+        function bytes = record(type, pointer, zone, frame, time, x, y)
+            % bytes = VirtualTracker.Stream.record(type, pointer, zone, frame, time, x, y)
+            % Pack a 24-byte record.
+            
+            bytes = [uint8(type), uint8(pointer), typecast(uint16(zone), 'uint8'), typecast(uint32(frame), 'uint8'), typecast(double(time), 'uint8'), typecast(single([x, y]), 'uint8')];
+        end
+    end
+end
\ No newline at end of file
@@ -26,11 +26,19 @@ function example
     targets.CC = transform([+0.00, +0.00, radius]);
     targets.CC = transform([+0.00, +0.00, radius]);
 
-    % Define tone callbacks with frequency (Hz) and duration (seconds).
-    callbacks.tone1 = @(data)callback(data.State, 1000, 0.500);
-    callbacks.tone2 = @(data)callback(data.State, 1500, 0.500);
-    callbacks.tone3 = @(data)callback(data.State, 2000, 0.500);
-    callbacks.tone4 = @(data)callback(data.State, 2500, 0.500);
+    % Pre-render tones with frequency (Hz) and duration (seconds) so that
+    % playback starts without delay when a zone is reached.
+    audio = Audio.Instance();
+    tones.tone1 = audio.tone(1000, 0.500);
+    tones.tone2 = audio.tone(1500, 0.500);
+    tones.tone3 = audio.tone(2000, 0.500);
+    tones.tone4 = audio.tone(2500, 0.500);
+    
+    % Define tone callbacks.
+    callbacks.tone1 = @(data)callback(data.State, audio, tones.tone1);
+    callbacks.tone2 = @(data)callback(data.State, audio, tones.tone2);
+    callbacks.tone3 = @(data)callback(data.State, audio, tones.tone3);
+    callbacks.tone4 = @(data)callback(data.State, audio, tones.tone4);
 
     % Define pairs of region/tone for each trial.
     zones = ...
@@ -68,9 +76,9 @@ function example
     obj.camera.mirror = [true, true];
     obj.camera.exposure = -5;
     
-    function callback(state, frequency, duration)
+    function callback(state, audio, key)
         if state
-            Tools.tone(frequency, duration);
+            audio.play(key);
         end
     end
 end
\ No newline at end of file
@@ -0,0 +1,188 @@
+/**
+ * @file AnalogStream.cpp
+ * @author Leonardo Molina (leonardomt@gmail.com).
+ * @date 2026-10-18
+ * @version 0.1.261018
+ * 
+ * @brief Sample analog inputs at a fixed rate and report them in packed blocks.
+ */
+
+#include <Arduino.h>
+#include "AnalogStream.h"
+#include "Monitor.h"
+
+namespace bridge {
+	AnalogStream* AnalogStream::instance = nullptr;
+	
+	AnalogStream::AnalogStream(const uint8_t* channels, uint8_t nChannels, uint16_t period, Function function) :
+	function(function),
+	nChannels(0),
+	mask(0),
+	period(period),
+	active(0),
+	index(0),
+	next(0),
+	ready(-1),
+	overruns(0)
+	{
+		// Sort channels, ignoring repetitions.
+		for (uint8_t c = 0; c < BRIDGE_ANALOG_CHANNELS; c++) {
+			for (uint8_t i = 0; i < nChannels; i++) {
+				if (channels[i] == c) {
+					this->channels[this->nChannels++] = c;
+					mask |= 1 << c;
+					break;
+				}
+			}
+		}
+		if (this->nChannels == 0)
+			return;
+		// Complete scans per block.
+		count = BRIDGE_ANALOG_SAMPLES / this->nChannels * this->nChannels;
+		instance = this;
+		sampleTime = micros();
+		
+		#ifdef __AVR__
+		noInterrupts();
+		// ADC: AVcc reference, conversion-complete interrupt, clock / 128 (125 kHz at 16 MHz, within the 50-200 kHz needed for full accuracy).
+		ADMUX = _BV(REFS0) | (this->channels[0] & 7);
+		ADCSRA = _BV(ADEN) | _BV(ADATE) | _BV(ADIE) | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0);
+		// Trigger conversions on Timer1 compare match B.
+		ADCSRB = _BV(ADTS2) | _BV(ADTS0);
+		#ifdef MUX5
+		if (this->channels[0] >= 8)
+			ADCSRB |= _BV(MUX5);
+		#endif
+		// Timer1: clear on compare match A, clock / 8; one conversion per match. The compare register is 16-bit,
+		// so intervals beyond 65536 ticks (32 ms at 16 MHz) are shortened to that.
+		uint32_t ticks = (uint32_t) period * (F_CPU / 8 / 1000000) / this->nChannels;
+		TCCR1A = 0;
+		TCCR1B = _BV(WGM12) | _BV(CS11);
+		OCR1A = ticks > 65536 ? 65535 : ticks > 1 ? ticks - 1 : 1;
+		OCR1B = OCR1A;
+		TCNT1 = 0;
+		TIFR1 = _BV(OCF1B);
+		interrupts();
+		#endif
+	}
+	
+	AnalogStream::~AnalogStream() {
+		#ifdef __AVR__
+		if (instance == this) {
+			ADCSRA = 0;
+			TCCR1B = 0;
+		}
+		#endif
+		if (instance == this)
+			instance = nullptr;
+	}
+	
+	void AnalogStream::OnConversion() {
+		#ifdef __AVR__
+		AnalogStream* stream = instance;
+		uint16_t value = ADC;
+		// Re-arm the trigger: conversions start on the rising edge of the compare flag.
+		TIFR1 = _BV(OCF1B);
+		Monitor::OnInterrupt();
+		if (stream == nullptr)
+			return;
+		// Select the channel of the next conversion, before the next trigger.
+		stream->next = stream->next + 1 == stream->nChannels ? 0 : stream->next + 1;
+		uint8_t channel = stream->channels[stream->next];
+		ADMUX = _BV(REFS0) | (channel & 7);
+		#ifdef MUX5
+		if (channel >= 8)
+			ADCSRB |= _BV(MUX5);
+		else
+			ADCSRB &= ~_BV(MUX5);
+		#endif
+		stream->Store(value);
+		#endif
+	}
+	
+	void AnalogStream::Store(uint16_t value) {
+		if (index == 0)
+			times[active] = micros();
+		buffers[active][index++] = value;
+		if (index == count) {
+			index = 0;
+			if (ready < 0) {
+				ready = active;
+				active ^= 1;
+			} else {
+				// Previous block not reported yet: drop this one; blocks hold complete scans, so channels stay aligned.
+				overruns++;
+			}
+		}
+	}
+	
+	void AnalogStream::Step() {
+		if (nChannels == 0)
+			return;
+		
+		#ifndef __AVR__
+		// Sample without interrupts: at most one scan per call; scans overdue beyond that are skipped and counted.
+		uint32_t elapsed = micros() - sampleTime;
+		if (elapsed >= period) {
+			uint32_t due = elapsed / period;
+			overruns += due - 1;
+			sampleTime += due * period;
+			for (uint8_t c = 0; c < nChannels; c++)
+				Store(analogRead(channels[c]));
+		}
+		#endif
+		
+		int8_t b;
+		noInterrupts();
+		b = ready;
+		interrupts();
+		if (b < 0)
+			return;
+		
+		// Header.
+		uint32_t time = times[b];
+		block[0] = time;
+		block[1] = time >> 8;
+		block[2] = time >> 16;
+		block[3] = time >> 24;
+		block[4] = period;
+		block[5] = period >> 8;
+		block[6] = mask;
+		block[7] = mask >> 8;
+		block[8] = count;
+		// Pack 4 samples in 5 bytes.
+		uint8_t* packed = block + BRIDGE_ANALOG_HEADER;
+		const uint16_t* samples = buffers[b];
+		uint8_t nSamples = (count + 3) & ~3;
+		for (uint8_t s = count; s < nSamples; s++)
+			buffers[b][s] = 0;
+		for (uint8_t s = 0; s < nSamples; s += 4) {
+			*packed++ = samples[s];
+			*packed++ = (samples[s] >> 8) | (samples[s + 1] << 2);
+			*packed++ = (samples[s + 1] >> 6) | (samples[s + 2] << 4);
+			*packed++ = (samples[s + 2] >> 4) | (samples[s + 3] << 6);
+			*packed++ = samples[s + 3] >> 2;
+		}
+		uint8_t length = BRIDGE_ANALOG_HEADER + (count * 10 + 7) / 8;
+		
+		// Release the buffer.
+		noInterrupts();
+		ready = -1;
+		interrupts();
+		function(this, block, length);
+	}
+	
+	uint32_t AnalogStream::GetOverruns() {
+		uint32_t n;
+		noInterrupts();
+		n = overruns;
+		interrupts();
+		return n;
+	}
+}
+
+#ifdef __AVR__
+ISR(ADC_vect) {
+	bridge::AnalogStream::OnConversion();
+}
+#endif
@@ -0,0 +1,100 @@
+/**
+ * @file AnalogStream.h
+ * @author Leonardo Molina (leonardomt@gmail.com).
+ * @date 2026-10-18
+ * @version 0.1.261018
+ * 
+ * @brief Sample analog inputs at a fixed rate and report them in packed blocks.
+ */
+
+#ifndef BRIDGE_ANALOGSTREAM_H
+#define BRIDGE_ANALOGSTREAM_H
+
+#include <stdint.h>
+#include "Stepper.h"
+
+/// Number of samples per block; a multiple of 4.
+#define BRIDGE_ANALOG_SAMPLES 32
+
+/// Maximum number of ADC channels.
+#define BRIDGE_ANALOG_CHANNELS 16
+
+/// Size of a block header (bytes).
+#define BRIDGE_ANALOG_HEADER 9
+
+/// Maximum size of a block (bytes).
+#define BRIDGE_ANALOG_BLOCK (BRIDGE_ANALOG_HEADER + BRIDGE_ANALOG_SAMPLES * 10 / 8)
+
+namespace bridge {
+	/**
+	 * @class AnalogStream
+	 * @brief Sample analog inputs at a fixed rate and report them in packed blocks.
+	 * @details On AVR boards, conversions are triggered by Timer1 (compare match B) and collected by the
+	 * conversion-complete interrupt into one of two buffers, while the other buffer is packed and reported
+	 * by Step. The interrupt routine is short, so that edges of digital inputs are still captured promptly.
+	 * Timer1 is reserved for this purpose (e.g. the Servo library cannot be used). Elsewhere, Step
+	 * samples with analogRead, one scan of all channels per call at most; scans missed while loop was busy
+	 * are skipped and counted as overruns. Only one instance may exist.
+	 * 
+	 * Channels are sampled in increasing order; on AVR, one conversion every period / number of channels,
+	 * which must be at least 104 us (13 ADC clocks at 125 kHz).
+	 * Block layout (little-endian):
+	 *   uint32: time (us) of the first sample.
+	 *   uint16: period (us) between scans of all channels.
+	 *   uint16: channel mask (bit c set if channel c is sampled).
+	 *   uint8: number of samples n.
+	 *   ceil(n * 10 / 8) bytes: samples, 10 bits each, least significant bits first, in order of
+	 *   acquisition (channel after channel, scan after scan).
+	 */
+	class AnalogStream : public Stepper {
+		public:
+			/// @typedef Function to invoke when a block is ready.
+			typedef void (*Function) (AnalogStream* analogStream, const uint8_t* block, uint8_t length);
+			
+			/**
+			 * @brief Sample ADC channels periodically.
+			 * @param[in] channels ADC channel numbers (e.g. 0 for A0).
+			 * @param[in] nChannels number of channels.
+			 * @param[in] period period (us) between scans of all channels.
+			 * @param[in] function function to invoke when a block is ready.
+			 */
+			AnalogStream(const uint8_t* channels, uint8_t nChannels, uint16_t period, Function function);
+			
+			/// @brief Stop sampling.
+			~AnalogStream();
+			
+			/**
+			 * @brief Report a block, if one is ready.
+			 * @return void
+			 */
+			void Step() override;
+			
+			/// @return count of blocks dropped because the previous one had not been reported, plus scans skipped (non-AVR).
+			uint32_t GetOverruns();
+			
+			/// @brief Collect a conversion; called from the conversion-complete interrupt.
+			static void OnConversion();
+			
+		private:
+			void Store(uint16_t value);										///< Store a sample and swap buffers when full.
+			
+			static AnalogStream* instance;									///< Instance served by the interrupt.
+			Function function;												///< Function invoked when a block is ready.
+			uint8_t channels[BRIDGE_ANALOG_CHANNELS];						///< Channels, in increasing order.
+			uint8_t nChannels;												///< Number of channels.
+			uint16_t mask;													///< Channel mask.
+			uint16_t period;												///< Period (us) between scans.
+			uint8_t count;													///< Number of samples per block.
+			uint16_t buffers[2][BRIDGE_ANALOG_SAMPLES];						///< Double buffer of samples.
+			uint32_t times[2];												///< Time (us) of the first sample of each buffer.
+			uint8_t active;													///< Buffer being filled.
+			uint8_t index;													///< Next sample in the active buffer.
+			uint8_t next;													///< Channel of the next conversion.
+			int8_t ready;													///< Buffer ready to be reported, or -1.
+			uint32_t overruns;												///< Count of dropped blocks and skipped scans.
+			uint32_t sampleTime;											///< Time (us) of the next scan, when sampled by Step.
+			uint8_t block[BRIDGE_ANALOG_BLOCK];								///< Packed block.
+	};
+}
+
+#endif
@@ -2,7 +2,7 @@
  * @file DigitalInput.cpp
  * @author Leonardo Molina (leonardomt@gmail.com).
  * @date 2016-12-01
- * @version 0.1.180710
+ * @version 0.1.261018
  * 
  * @brief Setup a GPIO as a digital input with pull-up, listen to digital changes, and report.
  */
@@ -10,28 +10,36 @@
 #include <Arduino.h>
 #include "DigitalInput.h"
 #include "meta.h"
+#include "Monitor.h"
 #include "tools.h"
 
 namespace bridge {
 	DigitalInput::DigitalInput(int8_t pin, Function function, FunctionData functionData, Data data) :
-	pin(pin),
+	port(BRIDGE_BASEREG(pin)),
+	mask(BRIDGE_BITMASK(pin)),
 	function(function),
 	functionData(functionData),
 	data(data),
-	port(BRIDGE_BASEREG(pin)),
-	mask(BRIDGE_BITMASK(pin)),
-	syncCount(0)
+	pin(pin),
+	syncCount(0),
+	syncTime(0),
+	width(0),
+	debounce(0),
+	asyncPending(false),
+	asyncGlitches(0)
 	{
 		// In case the pin is disconnected, a pull-up will keep a stable state.
 		pinMode(pin, INPUT_PULLUP);
-		int interruptId = digitalPinToInterrupt(pin);
+		// Force a report on the first step.
+		asyncCount = 1;
+		asyncState = BRIDGE_READ(port, mask);
+		polledState = asyncState;
+		asyncTime = micros();
+		syncState = !asyncState;
+		int interruptId = BRIDGE_INTERRUPT(pin);
 		if (interruptId >= 0) {
 			// If an interrupt is available, check states using the service routine instead of the step mechanism.
 			interruptible = true;
-			// Force a report on the first step.
-			asyncCount = 1;
-			asyncState = BRIDGE_READ(port, mask);
-			syncState = !asyncState;
 			/* std is not supported in Arduino and a lambda expression cannot be passed as an argument to
 			   functions when capturing. As a solution, forward from (*void)(void) to (*void)(uintptr_t) 
 			   using a compile-time lookup table (via metaprogramming):
@@ -40,65 +48,111 @@ namespace bridge {
 		} else {
 			// If an interrupt is not available, use the step mechanism.
 			interruptible = false;
-			// Force a report on the first step.
-			syncState = !BRIDGE_READ(port, mask);
 		}
 	}
 	
 	DigitalInput::~DigitalInput() {
 		// Remove interrupts from this pin.
-		detachInterrupt(digitalPinToInterrupt(pin));
+		if (interruptible)
+			detachInterrupt(BRIDGE_INTERRUPT(pin));
 	}
 	
 	void DigitalInput::OnChange(Data data) {
 		// Forward static call to object.
+		Monitor::OnInterrupt();
 		((DigitalInput*) data)->OnChange();
 	}
 	
 	void DigitalInput::OnChange() {
-		asyncState = BRIDGE_READ(port, mask);
-		asyncCount += 1;
+		bool state = BRIDGE_READ(port, mask);
+		Edge(state);
+	}
+	
+	void DigitalInput::Edge(bool state) {
+		uint32_t now = micros();
+		if (now - asyncTime < debounce) {
+			// Bounce: ignore; the pin is sampled again once the debounce period expires.
+			asyncGlitches += 1;
+			return;
+		}
+		if (asyncPending && now - asyncTime < width) {
+			// Pulse narrower than width: drop it along with the edge that started it.
+			asyncCount -= 1;
+			asyncPending = false;
+			asyncGlitches += 1;
+		} else {
+			asyncCount += 1;
+			asyncPending = width > 0;
+			asyncTime = now;
+		}
+		asyncState = state;
 	}
 	
 	void DigitalInput::Step() {
+		// Sample the pin in the absence of interrupts, as well as to capture changes ignored while debouncing.
 		bool state;
+		if (!interruptible || debounce > 0)
+			state = BRIDGE_READ(port, mask);
+		else
+			state = asyncState;
+		Poll(state);
+	}
+	
+	bool DigitalInput::Poll(bool state) {
 		uint32_t count;
 		uint32_t change;
-		// Reconcile count and state from last iteration.
-		if (interruptible) {
-			/* Disable interrupts briefly to safely copy multi-byte data that would
-			   otherwise be at risk of being changed halfways during a copy operation.
-			 */
-			noInterrupts();
-			state = asyncState;
-			count = asyncCount;
-			interrupts();
-			change = count - syncCount;
-		} else {
-			state = BRIDGE_READ(port, mask);
-			if (state == syncState) {
-				change = 0;
-				count = syncCount;
-			} else {
-				change = 1;
-				count = syncCount + 1;
-			}
+		uint32_t time;
+		bool latest;
+		bool busy;
+		/* Disable interrupts briefly to safely copy multi-byte data that would
+		   otherwise be at risk of being changed halfways during a copy operation.
+		 */
+		noInterrupts();
+		if (!interruptible && state != polledState && micros() - asyncTime < debounce) {
+			// Bounce seen by polling: count it as the interrupt routine would.
+			asyncGlitches += 1;
+		}
+		polledState = state;
+		if ((!interruptible || debounce > 0) && state != asyncState && micros() - asyncTime >= debounce)
+			Edge(state);
+		// Reconcile count from last iteration, holding back an edge that may still be rejected.
+		count = asyncCount;
+		if (asyncPending) {
+			if (micros() - asyncTime < width)
+				count -= 1;
+			else
+				asyncPending = false;
+		}
+		busy = asyncPending || state != asyncState;
+		time = asyncTime;
+		latest = count == asyncCount;
+		interrupts();
+		change = count - syncCount;
+		Monitor::OnCatchUp(change);
+		// Measure from the time of the edge, unless edges were missed or this is the initial report.
+		if (change == 1 && latest && syncCount > 0) {
+			pulseMeter.Edge(!syncState, time);
+			syncTime = time;
+		} else if (change > 0) {
+			pulseMeter.Skip();
+			syncTime = micros();
 		}
 		// Catch up with pin toggles, one at a time.
 		if (change > 0) {
 			if (function) {
-				for (int c = 0; c < change; c++) {
+				for (uint32_t c = 0; c < change; c++) {
 					syncState = !syncState;
 					function(this, syncState);
 				}
 			} else {
-				for (int c = 0; c < change; c++) {
+				for (uint32_t c = 0; c < change; c++) {
 					syncState = !syncState;
 					functionData(this, syncState, data);
 				}
 			}
 			syncCount = count;
 		}
+		return busy;
 	}
 	
 	bool DigitalInput::GetState() {
@@ -108,4 +162,39 @@ namespace bridge {
 	int8_t DigitalInput::GetPin() {
 		return pin;
 	}
+	
+	Port* DigitalInput::GetPort() {
+		return port;
+	}
+	
+	Mask DigitalInput::GetMask() {
+		return mask;
+	}
+	
+	bool DigitalInput::IsInterruptible() {
+		return interruptible;
+	}
+	
+	PulseMeter* DigitalInput::GetPulseMeter() {
+		return &pulseMeter;
+	}
+	
+	uint32_t DigitalInput::GetTime() {
+		return syncTime;
+	}
+	
+	void DigitalInput::SetFilter(uint32_t width, uint32_t debounce) {
+		noInterrupts();
+		this->width = width;
+		this->debounce = debounce;
+		interrupts();
+	}
+	
+	uint32_t DigitalInput::GetGlitches() {
+		uint32_t glitches;
+		noInterrupts();
+		glitches = asyncGlitches;
+		interrupts();
+		return glitches;
+	}
 }
\ No newline at end of file
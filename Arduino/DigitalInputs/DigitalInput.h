@@ -2,7 +2,7 @@
  * @file DigitalInput.h
  * @author Leonardo Molina (leonardomt@gmail.com).
  * @date 2016-12-01
- * @version 0.1.180710
+ * @version 0.1.261018
  * 
  * @brief Setup a GPIO as a digital input with pull-up, listen to digital changes, and report.
  */
@@ -11,7 +11,9 @@
 #define BRIDGE_DIGITALINPUT_H
 
 #include <stdint.h>
+#include "PulseMeter.h"
 #include "Stepper.h"
+#include "tools.h"
 
 namespace bridge {
 	/**
@@ -21,6 +23,7 @@ namespace bridge {
 	 * The Step method must be called regularly (e.g. from the Arduino loop function) in order to
 	 * report changes promptly and capture changes in the absence of interrupts.
 	 * When possible, the class uses direct port manipulation to access pin state faster than Arduino's digitalRead.
+	 * Optionally, pulses narrower than a minimum width and bounces following a change are rejected (see SetFilter).
 	 */
 	class DigitalInput : public Stepper {
 		public:
@@ -60,12 +63,51 @@ namespace bridge {
 			 */
 			void Step() override;
 			
+			/**
+			 * @brief Process a state of the pin sampled elsewhere (e.g. by a PortGroup), report changes, if any.
+			 * @param[in] state pin state.
+			 * @return whether the input must be polled again even if the pin does not change,
+			 * e.g. to release an edge held back by the glitch filter.
+			 */
+			bool Poll(bool state);
+			
 			/// @return current digital state of the pin.
 			bool GetState();
 			
 			/// @return pin number.
 			int8_t GetPin();
 			
+			/// @return time (us) of the change being reported; the time of the report if changes were missed.
+			uint32_t GetTime();
+			
+			/// @return hardware address of the pin.
+			Port* GetPort();
+			
+			/// @return mask to single out the pin in its hardware address.
+			Mask GetMask();
+			
+			/// @return whether changes to the pin are captured by an interrupt.
+			bool IsInterruptible();
+			
+			/// @return measurements of high time, low time, and period, from the time of each reported change.
+			PulseMeter* GetPulseMeter();
+			
+			/**
+			 * @brief Reject pulses narrower than a minimum width and ignore bounces following a change.
+			 * @details Each edge is timestamped as it is captured (by the interrupt routine, or by Step in
+			 * the absence of interrupts). An edge arriving within width of the previous one cancels it, so
+			 * that the pulse is never reported; as a consequence, changes are reported after a delay of width.
+			 * Edges arriving within debounce of the last accepted edge are ignored, and the pin is read again
+			 * once the debounce period expires.
+			 * @param[in] width minimum pulse width (us); 0 disables the filter.
+			 * @param[in] debounce period (us) during which changes following a change are ignored; 0 disables it.
+			 * @return void
+			 */
+			void SetFilter(uint32_t width, uint32_t debounce);
+			
+			/// @return count of rejected glitches and bounces, whether seen by the interrupt routine or by polling.
+			uint32_t GetGlitches();
+			
 		private:
 			/**
 			 * @brief Listen and report pin changes. This private constructor is used for two construction delegates.
@@ -77,8 +119,8 @@ namespace bridge {
 			 */
 			DigitalInput(int8_t pin, Function function, FunctionData functionData, Data data);
 			
-			volatile uint8_t* port;				///< Hardware address of the pin.
-			uint8_t mask;						///< Mask to single out in the hardware address.
+			Port* port;							///< Hardware address of the pin.
+			Mask mask;							///< Mask to single out in the hardware address.
 			
 			Function function;					///< Listener function invoked when pin toggles its state.
 			FunctionData functionData;			///< Listener function invoked when pin toggles its state.
@@ -87,12 +129,23 @@ namespace bridge {
 			int8_t pin;							///< Pin number the object is processing.
 			static void OnChange(Data data);	///< Call a method from the static context of an interrupt service routine.
 			void OnChange();					///< Recipient method to the static analogous with the same name.
+			void Edge(bool state);				///< Accept or reject an edge, given the state that followed.
 			bool interruptible;					///< Whether changes to this pin are captured by an interrupt.
 			
 			uint32_t asyncCount;				///< Count of state changes in the "interrupt thread".
 			bool asyncState;					///< Pin state in the "interrupt thread".
 			uint32_t syncCount;					///< Count of state changes in the "main thread".
 			bool syncState;						///< Pin state in the "main thread".
+			uint32_t syncTime;					///< Time (us) of the change being reported.
+			
+			uint32_t width;						///< Minimum pulse width (us).
+			uint32_t debounce;					///< Period (us) during which changes following a change are ignored.
+			uint32_t asyncTime;					///< Time (us) of the last accepted edge in the "interrupt thread".
+			bool asyncPending;					///< Whether the last accepted edge may still be rejected as a glitch.
+			uint32_t asyncGlitches;				///< Count of rejected edges in the "interrupt thread".
+			bool polledState;					///< Pin state last seen by Poll.
+			
+			PulseMeter pulseMeter;				///< Measurements of high time, low time, and period.
 	};
 }
 
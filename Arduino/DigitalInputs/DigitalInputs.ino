@@ -6,51 +6,369 @@
  *   bit 7 indicates a positive or a negative change with 0 or 1, respectively.
  *   bit 8 is always set to zero to allow for an extended protocol definition.
  * 
+ * Extended packets start with a byte with bit 8 set:
+ *   byte 1: 128 + packet type.
+ *   byte 2: payload length n.
+ *   bytes 3 to n + 2: payload (multi-byte values are little-endian).
+ * Packet types:
+ *   1: rejected glitches. Payload: pin (uint8), count (uint32).
+ *   2: loop timing and interrupt load, when BRIDGE_INSTRUMENT is defined (see Monitor.h).
+ *   3: block of analog samples (see AnalogStream.h).
+ *   4: pulse measurements. Payload: pin (uint8), followed by high time, low time, and period (see PulseMeter.h).
+ *   5: sync pulse, emitted (master) or received (slave). Payload: code (uint8), time (uint32, us).
+ *   6: timestamped change, sent instead of single bytes if enabled. Payload: single byte as above, time (uint32, us).
+ *   7: zone entry or exit. Payload: zone (uint8), state (uint8), frame (uint16), time (uint32, us).
+ *   8: task statistics, when BRIDGE_INSTRUMENT is defined. Payload: overruns and misses (uint32) of each task (see Scheduler.h).
+ *   9: hello, in reply to a hello from the host. Payload: protocol version, flags, baudrate, batch size (see Transport.h).
+ * 
+ * Commands from the host are extended packets of the same form:
+ *   4: report pulse measurements of all inputs. No payload.
+ *   7: set a zone (see ZoneTable.h). Payload: zone (uint8), shape (uint8), output pin (int8, -1 for none),
+ *      3 (circle) or 4 (rectangle) parameters (int16, fixed point).
+ *   8: test a position against all zones. Payload: x (int16, fixed point), y (int16), frame (uint16).
+ *   9: hello, to discover the baudrate and capabilities of the firmware. No payload.
+ * A command left incomplete for commandTimeout is discarded, e.g. bytes received while the host tries another baudrate.
+ * 
  * @file DigitalInputs.ino
  * @author Leonardo Molina (leonardomt@gmail.com)
  * @date 2016-12-01
- * @version: 0.1.180710
+ * @version: 0.1.261018
  */
 
+#include "AnalogStream.h"
 #include "DigitalInput.h"
+#include "Monitor.h"
+#include "PortGroup.h"
+#include "Scheduler.h"
+#include "SyncMaster.h"
+#include "SyncSlave.h"
+#include "tools.h"
+#include "Transport.h"
+#include "ZoneTable.h"
 
 using namespace bridge;
 
-/// Serial communication baudrate.
-const int32_t baudrate = 115200;
+/// Serial communication baudrate of a UART (e.g. 115200, 1000000 or 2000000); irrelevant with native USB.
+const int32_t baudrate = 1000000;
+
+/// Serial port, written in batches.
+Transport transport;
 
 /// GPIO to configure as digital inputs.
 const int8_t digitalInputPins[] = {16, 17, 18, 19};
 
+/// Minimum pulse width (us) of each digital input; narrower pulses are rejected (e.g. 100 for noisy cables).
+const uint32_t digitalInputWidths[] = {0, 0, 0, 0};
+
+/// Period (us) after a change during which further changes of each digital input are ignored.
+const uint32_t digitalInputDebounces[] = {0, 0, 0, 0};
+
+/// Whether changes are reported with the time they occurred (packet type 6), e.g. to align several boards.
+const bool digitalInputTimes = false;
+
 /// Digital input array size.
 const int8_t nDigitalInputs = sizeof(digitalInputPins);
 
 /// Digital input object array.
 DigitalInput** digitalInputs = new DigitalInput*[nDigitalInputs];
 
+/// Inputs without interrupts, polled together by port.
+PortGroup portGroup;
+
+/// Inputs not polled by the port group (e.g. captured by interrupts), stepped on their own.
+DigitalInput** interruptInputs = new DigitalInput*[nDigitalInputs];
+
+/// Number of inputs captured by interrupts.
+int8_t nInterruptInputs = 0;
+
+/// Period (ms) between reports of rejected glitches.
+const uint32_t glitchPeriod = 1000;
+
+/// Count of rejected glitches last reported for each digital input.
+uint32_t* glitchCounts = new uint32_t[nDigitalInputs]();
+
+/// Time (ms) of the last report of rejected glitches.
+uint32_t glitchTime = 0;
+
+/// ADC channels to sample (e.g. 0 for A0).
+const uint8_t analogChannels[] = {0, 1};
+
+/// Number of ADC channels to sample; 0 disables analog sampling.
+const uint8_t nAnalogChannels = 0;
+
+/// Period (us) between scans of all ADC channels.
+const uint16_t analogPeriod = 1000;
+
+/// Analog stream, if enabled.
+AnalogStream* analogStream = nullptr;
+
+/// Period (ms) between reports of pulse measurements; 0 reports on request only.
+const uint32_t pulsePeriod = 0;
+
+/// Time (ms) of the last report of pulse measurements.
+uint32_t pulseTime = 0;
+
+/// Extended packet being received from the host.
+uint8_t command[64];
+
+/// Number of bytes of the extended packet received so far.
+uint16_t nCommand = 0;
+
+/// Time (ms) the last byte of a command was received.
+uint32_t commandTime = 0;
+
+/// Period (ms) after which an incomplete command is discarded.
+const uint32_t commandTimeout = 50;
+
+/// Sync line mode: 0 disabled, 1 master (emit coded pulses), 2 slave (timestamp coded pulses).
+const uint8_t syncMode = 0;
+
+/// Sync line GPIO; a slave should use a pin with a hardware interrupt.
+const int8_t syncPin = 2;
+
+/// Period (ms) between sync pulses emitted by a master.
+const uint32_t syncPeriod = 1000;
+
+/// Sync line master or slave, if enabled.
+Stepper* sync = nullptr;
+
+/// Zones tested against positions received from the host.
+ZoneTable zoneTable(zoneResponse);
+
+/// Frame of the last position received from the host.
+uint16_t zoneFrame = 0;
+
+/// Steps inputs in every pass, and other tasks at their own period.
+Scheduler scheduler;
+
+/// Period (us) between steps of the analog stream, and its budget.
+const uint32_t analogStepPeriod = 1000;
+const uint32_t analogStepBudget = 400;
+
+/// Loop timing and interrupt load, reported every second.
+Monitor monitor(1000);
+
 /// Arduino library setup.
 void setup() {
 	// Initialize serial communication.
-	Serial.begin(baudrate);
+	transport.Begin(baudrate);
+	
+	// Start the counter used to time steps (see tools.h).
+	BRIDGE_TICKS_BEGIN();
 	
 	// Setup digital inputs.
-	for (int i = 0; i < nDigitalInputs; i++)
+	for (int i = 0; i < nDigitalInputs; i++) {
 		digitalInputs[i] = new DigitalInput(digitalInputPins[i], digitalResponse);
+		digitalInputs[i]->SetFilter(digitalInputWidths[i], digitalInputDebounces[i]);
+		if (!portGroup.Add(digitalInputs[i]))
+			interruptInputs[nInterruptInputs++] = digitalInputs[i];
+	}
+	
+	// Setup sync line.
+	if (syncMode == 1)
+		sync = new SyncMaster(syncPin, syncPeriod, syncMasterResponse);
+	else if (syncMode == 2)
+		sync = new SyncSlave(syncPin, syncSlaveResponse);
+	
+	// Setup analog inputs.
+	if (nAnalogChannels > 0)
+		analogStream = new AnalogStream(analogChannels, nAnalogChannels, analogPeriod, analogResponse);
+	
+	// Inputs and the sync line are stepped in every pass; analog blocks are packed periodically.
+	scheduler.Add(&portGroup, 0, 0, 0);
+	for (int i = 0; i < nInterruptInputs; i++)
+		scheduler.Add(interruptInputs[i], 0, 1, 0);
+	if (sync)
+		scheduler.Add(sync, 0, 0, 0);
+	if (analogStream)
+		scheduler.Add(analogStream, analogStepPeriod, 2, analogStepBudget);
 }
 
 /// Arduino library loop.
 void loop() {
-	for (int i = 0; i < nDigitalInputs; i++)
-		digitalInputs[i]->Step();
+	if (monitor.Loop())
+		sendMonitor();
+	receive();
+	
+	scheduler.Step();
+	
+	// Report pulse measurements periodically, if requested.
+	if (pulsePeriod > 0 && millis() - pulseTime >= pulsePeriod) {
+		pulseTime = millis();
+		sendPulses();
+	}
+	
+	// Report counts of rejected glitches that changed since the last report.
+	if (millis() - glitchTime >= glitchPeriod) {
+		glitchTime = millis();
+		for (int i = 0; i < nDigitalInputs; i++) {
+			uint32_t glitches = digitalInputs[i]->GetGlitches();
+			if (glitches != glitchCounts[i]) {
+				glitchCounts[i] = glitches;
+				sendGlitches(digitalInputs[i]->GetPin(), glitches);
+			}
+		}
+	}
+	
+	// Hand bytes queued in this pass to Serial, in as few packets as possible.
+	transport.Flush();
 }
 
 /// Process a response from DigitalInput.
 void digitalResponse(DigitalInput* digitalInput, bool state) {
-	sendState(digitalInput->GetPin(), state);
+	if (digitalInputTimes)
+		sendStateTime(digitalInput->GetPin(), state, digitalInput->GetTime());
+	else
+		sendState(digitalInput->GetPin(), state);
+}
+
+/// Report a sync pulse emitted.
+void syncMasterResponse(SyncMaster*, uint8_t code, uint32_t time) {
+	sendSync(code, time);
+}
+
+/// Report a sync pulse received.
+void syncSlaveResponse(SyncSlave*, uint8_t code, uint32_t time) {
+	sendSync(code, time);
 }
 
 /// Encode and send state changes.
 void sendState(uint8_t pin, bool state) {
 	const int8_t lowMask = 64;
-	Serial.write(state ? (uint8_t) pin : (uint8_t) (pin + lowMask));
+	transport.Write(state ? (uint8_t) pin : (uint8_t) (pin + lowMask));
+}
+
+/// Report a zone entry or exit, after its output changed.
+void zoneResponse(ZoneTable*, uint8_t zone, bool state) {
+	const uint8_t type = 7;
+	uint32_t time = micros();
+	uint8_t payload[] = {zone, state, (uint8_t) zoneFrame, (uint8_t) (zoneFrame >> 8), (uint8_t) time, (uint8_t) (time >> 8), (uint8_t) (time >> 16), (uint8_t) (time >> 24)};
+	sendExtended(type, payload, sizeof(payload));
+}
+
+/// Encode and send state changes along with their time.
+void sendStateTime(uint8_t pin, bool state, uint32_t time) {
+	const uint8_t type = 6;
+	const int8_t lowMask = 64;
+	uint8_t payload[] = {state ? (uint8_t) pin : (uint8_t) (pin + lowMask), (uint8_t) time, (uint8_t) (time >> 8), (uint8_t) (time >> 16), (uint8_t) (time >> 24)};
+	sendExtended(type, payload, sizeof(payload));
+}
+
+/// Encode and send the code and time of a sync pulse.
+void sendSync(uint8_t code, uint32_t time) {
+	const uint8_t type = 5;
+	uint8_t payload[] = {code, (uint8_t) time, (uint8_t) (time >> 8), (uint8_t) (time >> 16), (uint8_t) (time >> 24)};
+	sendExtended(type, payload, sizeof(payload));
+}
+
+/// Parse commands from the host; commands that do not fit in the buffer, or left incomplete, are skipped.
+void receive() {
+	if (nCommand > 0 && millis() - commandTime >= commandTimeout)
+		nCommand = 0;
+	while (Serial.available() > 0) {
+		uint8_t value = Serial.read();
+		commandTime = millis();
+		if (nCommand == 0 && (value & 128) == 0)
+			continue;
+		if (nCommand < sizeof(command))
+			command[nCommand] = value;
+		nCommand++;
+		if (nCommand >= 2 && nCommand == 2 + command[1]) {
+			if (nCommand <= sizeof(command))
+				onCommand(command[0] & 127, command + 2, command[1]);
+			nCommand = 0;
+		}
+	}
+}
+
+/// Process a command from the host.
+void onCommand(uint8_t type, const uint8_t* payload, uint8_t length) {
+	switch (type) {
+		case 4:
+			sendPulses();
+			break;
+		case 7:
+			if (length >= 3) {
+				int16_t parameters[4] = {0, 0, 0, 0};
+				for (uint8_t p = 0; p < 4 && 3 + 2 * p + 1 < length; p++)
+					parameters[p] = (int16_t) (payload[3 + 2 * p] | (payload[4 + 2 * p] << 8));
+				zoneTable.Set(payload[0], (ZoneTable::Shape) payload[1], (int8_t) payload[2], parameters);
+			}
+			break;
+		case 8:
+			if (length >= 6) {
+				zoneFrame = payload[4] | (payload[5] << 8);
+				zoneTable.Update((int16_t) (payload[0] | (payload[1] << 8)), (int16_t) (payload[2] | (payload[3] << 8)));
+			}
+			break;
+		case 9:
+			sendHello();
+			break;
+	}
+}
+
+/// Encode and send pulse measurements of all inputs, and restart them.
+void sendPulses() {
+	const uint8_t type = 4;
+	uint8_t payload[1 + BRIDGE_PULSE_REPORT];
+	for (int i = 0; i < nDigitalInputs; i++) {
+		payload[0] = digitalInputs[i]->GetPin();
+		digitalInputs[i]->GetPulseMeter()->Report(payload + 1);
+		sendExtended(type, payload, sizeof(payload));
+	}
+}
+
+/// Send a block of analog samples.
+void analogResponse(AnalogStream*, const uint8_t* block, uint8_t length) {
+	const uint8_t type = 3;
+	sendExtended(type, block, length);
+}
+
+/// Encode and send the count of rejected glitches of a pin.
+void sendGlitches(uint8_t pin, uint32_t count) {
+	const uint8_t type = 1;
+	uint8_t payload[] = {pin, (uint8_t) count, (uint8_t) (count >> 8), (uint8_t) (count >> 16), (uint8_t) (count >> 24)};
+	sendExtended(type, payload, sizeof(payload));
+}
+
+/// Encode and send loop timing and interrupt load.
+void sendMonitor() {
+	const uint8_t type = 2;
+	uint8_t payload[BRIDGE_MONITOR_REPORT];
+	monitor.Report(payload);
+	sendExtended(type, payload, sizeof(payload));
+	sendTasks();
+}
+
+/// Encode and send overruns and misses of each task.
+void sendTasks() {
+	const uint8_t type = 8;
+	uint8_t payload[8 * BRIDGE_MAX_TASKS];
+	uint8_t length = 0;
+	for (uint8_t t = 0; t < scheduler.GetCount(); t++) {
+		uint32_t values[] = {scheduler.GetOverruns(t), scheduler.GetMisses(t)};
+		for (uint8_t v = 0; v < 2; v++) {
+			payload[length++] = values[v];
+			payload[length++] = values[v] >> 8;
+			payload[length++] = values[v] >> 16;
+			payload[length++] = values[v] >> 24;
+		}
+	}
+	sendExtended(type, payload, length);
+}
+
+/// Describe the link to the host.
+void sendHello() {
+	const uint8_t type = 9;
+	uint8_t payload[BRIDGE_TRANSPORT_HELLO];
+	transport.Hello(payload);
+	sendExtended(type, payload, sizeof(payload));
+}
+
+/// Send an extended packet.
+void sendExtended(uint8_t type, const uint8_t* payload, uint8_t length) {
+	const uint8_t extendedMask = 128;
+	transport.Write((uint8_t) (type + extendedMask));
+	transport.Write(length);
+	transport.Write(payload, length);
 }
\ No newline at end of file
@@ -0,0 +1,93 @@
+/**
+ * @file Monitor.cpp
+ * @author Leonardo Molina (leonardomt@gmail.com).
+ * @date 2026-10-18
+ * @version 0.1.261018
+ * 
+ * @brief Measure loop timing and interrupt load.
+ */
+
+#include <Arduino.h>
+#include "Monitor.h"
+
+#ifndef SERIAL_TX_BUFFER_SIZE
+#define SERIAL_TX_BUFFER_SIZE 64
+#endif
+
+namespace bridge {
+	volatile uint32_t Monitor::interruptCount = 0;
+	uint32_t Monitor::catchUp = 0;
+	uint16_t Monitor::stepMax = 0;
+	
+	Monitor::Monitor(uint32_t period) :
+	period(period),
+	reportTime(0),
+	loopTime(0),
+	loopMax(0),
+	txMin(SERIAL_TX_BUFFER_SIZE)
+	{
+		for (uint8_t b = 0; b < BRIDGE_MONITOR_BINS; b++)
+			histogram[b] = 0;
+	}
+	
+	bool Monitor::Loop() {
+		#ifdef BRIDGE_INSTRUMENT
+		uint32_t now = micros();
+		if (loopTime > 0) {
+			uint32_t elapsed = now - loopTime;
+			// Bin by powers of two, starting at 4us.
+			uint8_t b = 0;
+			for (uint32_t edge = 8; elapsed >= edge && b < BRIDGE_MONITOR_BINS - 1; edge <<= 1)
+				b++;
+			if (histogram[b] < UINT16_MAX)
+				histogram[b]++;
+			if (elapsed > loopMax)
+				loopMax = elapsed > UINT16_MAX ? UINT16_MAX : elapsed;
+		}
+		loopTime = now;
+		uint16_t txFree = Serial.availableForWrite();
+		if (txFree < txMin)
+			txMin = txFree;
+		return millis() - reportTime >= period;
+		#else
+		return false;
+		#endif
+	}
+	
+	void Monitor::Report(uint8_t* report) {
+		uint32_t now = millis();
+		uint32_t elapsed = now - reportTime;
+		reportTime = now;
+		noInterrupts();
+		uint32_t count = interruptCount;
+		interruptCount = 0;
+		interrupts();
+		uint32_t rate = elapsed > 0 ? (uint32_t) (1000ull * count / elapsed) : 0;
+		uint16_t txHighWater = SERIAL_TX_BUFFER_SIZE - txMin;
+		uint16_t depth = catchUp > UINT16_MAX ? UINT16_MAX : catchUp;
+		
+		uint8_t i = 0;
+		for (uint8_t b = 0; b < BRIDGE_MONITOR_BINS; b++) {
+			report[i++] = histogram[b];
+			report[i++] = histogram[b] >> 8;
+			histogram[b] = 0;
+		}
+		report[i++] = loopMax;
+		report[i++] = loopMax >> 8;
+		report[i++] = stepMax;
+		report[i++] = stepMax >> 8;
+		report[i++] = rate;
+		report[i++] = rate >> 8;
+		report[i++] = rate >> 16;
+		report[i++] = rate >> 24;
+		report[i++] = txHighWater;
+		report[i++] = txHighWater >> 8;
+		report[i++] = depth;
+		report[i++] = depth >> 8;
+		
+		loopMax = 0;
+		stepMax = 0;
+		txMin = SERIAL_TX_BUFFER_SIZE;
+		catchUp = 0;
+	}
+}
@@ -0,0 +1,103 @@
+/**
+ * @file Monitor.h
+ * @author Leonardo Molina (leonardomt@gmail.com).
+ * @date 2026-10-18
+ * @version 0.1.261018
+ * 
+ * @brief Measure loop timing and interrupt load.
+ */
+
+#ifndef BRIDGE_MONITOR_H
+#define BRIDGE_MONITOR_H
+
+#include <stdint.h>
+
+/// Uncomment to measure loop timing and interrupt load; otherwise the monitor costs nothing.
+// #define BRIDGE_INSTRUMENT
+
+/// Number of bins in the histogram of loop periods.
+#define BRIDGE_MONITOR_BINS 8
+
+/// Size of a report (bytes).
+#define BRIDGE_MONITOR_REPORT 28
+
+namespace bridge {
+	/**
+	 * @class Monitor
+	 * @brief Measure loop timing and interrupt load, and summarize them periodically.
+	 * @details Measures the loop period (histogram and maximum), the maximum duration of a Step,
+	 * the rate of interrupts, the high-water mark of the serial transmission buffer, and the maximum
+	 * number of toggles replayed by a DigitalInput in a single step (catch-up depth).
+	 * Measurements are only taken when BRIDGE_INSTRUMENT is defined.
+	 * 
+	 * Report layout (little-endian):
+	 *   uint16 x 8: loop period histogram; bin b counts periods in [2^(b + 2), 2^(b + 3)) us, the
+	 *               first bin includes shorter periods and the last bin includes longer periods.
+	 *   uint16: maximum loop period (us).
+	 *   uint16: maximum Step duration (us).
+	 *   uint32: interrupts per second.
+	 *   uint16: serial transmission buffer high-water mark (bytes).
+	 *   uint16: catch-up depth.
+	 */
+	class Monitor {
+		public:
+			/**
+			 * @brief Summarize measurements periodically.
+			 * @param[in] period report period (ms).
+			 */
+			Monitor(uint32_t period);
+			
+			/**
+			 * @brief Take loop measurements; call at the beginning of every loop.
+			 * @return whether a report is due.
+			 */
+			bool Loop();
+			
+			/**
+			 * @brief Summarize measurements since the last report and restart them.
+			 * @param[out] report BRIDGE_MONITOR_REPORT bytes.
+			 * @return void
+			 */
+			void Report(uint8_t* report);
+			
+			/// @brief Count an interrupt; called from interrupt service routines.
+			static inline void OnInterrupt() {
+				#ifdef BRIDGE_INSTRUMENT
+				interruptCount++;
+				#endif
+			}
+			
+			/// @brief Register the duration (us) of a step, e.g. from a Scheduler.
+			static inline void OnStep(uint32_t elapsed) {
+				#ifdef BRIDGE_INSTRUMENT
+				if (elapsed > stepMax)
+					stepMax = elapsed > UINT16_MAX ? UINT16_MAX : elapsed;
+				#else
+				(void) elapsed;
+				#endif
+			}
+			
+			/// @brief Register the number of toggles replayed in a single step.
+			static inline void OnCatchUp(uint32_t change) {
+				#ifdef BRIDGE_INSTRUMENT
+				if (change > catchUp)
+					catchUp = change;
+				#else
+				(void) change;
+				#endif
+			}
+			
+		private:
+			uint32_t period;								///< Report period (ms).
+			uint32_t reportTime;							///< Time (ms) of the last report.
+			uint32_t loopTime;								///< Time (us) at which the last loop started.
+			uint16_t histogram[BRIDGE_MONITOR_BINS];		///< Count of loop periods per bin.
+			uint16_t loopMax;								///< Maximum loop period (us).
+			uint16_t txMin;									///< Minimum free space in the serial transmission buffer (bytes).
+			static volatile uint32_t interruptCount;		///< Count of interrupts since the last report.
+			static uint32_t catchUp;						///< Maximum toggles replayed in a single step since the last report.
+			static uint16_t stepMax;						///< Maximum Step duration (us) since the last report.
+	};
+}
+
+#endif
@@ -0,0 +1,65 @@
+/**
+ * @file PortGroup.cpp
+ * @author Leonardo Molina (leonardomt@gmail.com).
+ * @date 2026-10-18
+ * @version 0.1.261018
+ * 
+ * @brief Poll digital inputs sharing a port with a single read of the port.
+ */
+
+#include <Arduino.h>
+#include "PortGroup.h"
+
+namespace bridge {
+	bool PortGroup::Add(DigitalInput* digitalInput) {
+		#ifdef BRIDGE_FAST_IO
+		if (digitalInput->IsInterruptible())
+			return false;
+		Port* port = digitalInput->GetPort();
+		uint8_t p = 0;
+		while (p < nPorts && ports[p] != port)
+			p++;
+		if (p == nPorts) {
+			if (nPorts == BRIDGE_MAX_PORTS)
+				return false;
+			ports[p] = port;
+			masks[p] = 0;
+			pending[p] = 0;
+			snapshots[p] = BRIDGE_READ_PORT(port);
+			for (uint8_t b = 0; b < BRIDGE_PORT_WIDTH; b++)
+				inputs[p][b] = nullptr;
+			nPorts++;
+		}
+		Mask mask = digitalInput->GetMask();
+		for (uint8_t b = 0; b < BRIDGE_PORT_WIDTH; b++) {
+			if (mask & ((Mask) 1 << b))
+				inputs[p][b] = digitalInput;
+		}
+		masks[p] |= mask;
+		// Poll on the first step to report the initial state.
+		pending[p] |= mask;
+		return true;
+		#else
+		(void) digitalInput;
+		return false;
+		#endif
+	}
+	
+	void PortGroup::Step() {
+		for (uint8_t p = 0; p < nPorts; p++) {
+			Mask state = BRIDGE_READ_PORT(ports[p]);
+			Mask changes = ((state ^ snapshots[p]) & masks[p]) | pending[p];
+			snapshots[p] = state;
+			pending[p] = 0;
+			// Dispatch changed pins only.
+			for (uint8_t b = 0; changes; b++) {
+				Mask bit = (Mask) 1 << b;
+				if (changes & bit) {
+					changes &= ~bit;
+					if (inputs[p][b]->Poll(state & bit))
+						pending[p] |= bit;
+				}
+			}
+		}
+	}
+}
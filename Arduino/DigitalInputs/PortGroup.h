@@ -0,0 +1,59 @@
+/**
+ * @file PortGroup.h
+ * @author Leonardo Molina (leonardomt@gmail.com).
+ * @date 2026-10-18
+ * @version 0.1.261018
+ * 
+ * @brief Poll digital inputs sharing a port with a single read of the port.
+ */
+
+#ifndef BRIDGE_PORTGROUP_H
+#define BRIDGE_PORTGROUP_H
+
+#include <stdint.h>
+#include "DigitalInput.h"
+#include "Stepper.h"
+#include "tools.h"
+
+/// Maximum number of ports polled by a group.
+#define BRIDGE_MAX_PORTS 12
+
+namespace bridge {
+	/**
+	 * @class PortGroup
+	 * @brief Poll digital inputs sharing a port with a single read of the port.
+	 * @details Each port is read once per step and compared against the previous reading; only inputs
+	 * whose pins changed (or that have changes pending, see DigitalInput::Poll) are processed. The cost
+	 * of a step is proportional to the number of ports rather than to the number of inputs.
+	 * Inputs captured by interrupts are not grouped and must be stepped on their own.
+	 */
+	class PortGroup : public Stepper {
+		public:
+			/// @brief Default constructor.
+			PortGroup() : nPorts(0) {};
+			
+			/**
+			 * @brief Poll an input along with other inputs in its port.
+			 * @param[in] digitalInput input to poll.
+			 * @return whether the input was added; inputs captured by interrupts, in excess of
+			 * BRIDGE_MAX_PORTS ports, or in architectures without direct port access (see tools.h), are not added.
+			 */
+			bool Add(DigitalInput* digitalInput);
+			
+			/**
+			 * @brief Read each port once and process inputs that changed.
+			 * @return void
+			 */
+			void Step() override;
+			
+		private:
+			Port* ports[BRIDGE_MAX_PORTS];								///< Hardware address of each port.
+			Mask masks[BRIDGE_MAX_PORTS];								///< Pins of each port that belong to an input.
+			Mask snapshots[BRIDGE_MAX_PORTS];							///< Port state in the previous step.
+			Mask pending[BRIDGE_MAX_PORTS];								///< Pins of each port that must be polled regardless of changes.
+			DigitalInput* inputs[BRIDGE_MAX_PORTS][BRIDGE_PORT_WIDTH];	///< Input assigned to each pin of each port.
+			uint8_t nPorts;												///< Number of ports in use.
+	};
+}
+
+#endif
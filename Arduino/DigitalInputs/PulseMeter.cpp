@@ -0,0 +1,82 @@
+/**
+ * @file PulseMeter.cpp
+ * @author Leonardo Molina (leonardomt@gmail.com).
+ * @date 2026-10-18
+ * @version 0.1.261018
+ * 
+ * @brief Measure high time, low time, and period of a digital signal from its edges.
+ */
+
+#include "PulseMeter.h"
+
+namespace bridge {
+	PulseMeter::PulseMeter() :
+	riseValid(false),
+	fallValid(false)
+	{
+		high.Reset();
+		low.Reset();
+		period.Reset();
+	}
+	
+	void PulseMeter::Edge(bool state, uint32_t time) {
+		if (state) {
+			if (fallValid)
+				low.Add(time - fallTime);
+			if (riseValid)
+				period.Add(time - riseTime);
+			riseTime = time;
+			riseValid = true;
+		} else {
+			if (riseValid)
+				high.Add(time - riseTime);
+			fallTime = time;
+			fallValid = true;
+		}
+	}
+	
+	void PulseMeter::Skip() {
+		riseValid = false;
+		fallValid = false;
+	}
+	
+	void PulseMeter::Report(uint8_t* report) {
+		report = high.Write(report);
+		report = low.Write(report);
+		report = period.Write(report);
+		high.Reset();
+		low.Reset();
+		period.Reset();
+	}
+	
+	void PulseMeter::Statistic::Add(uint32_t value) {
+		if (count == UINT16_MAX)
+			return;
+		count++;
+		sum += value;
+		if (value < min)
+			min = value;
+		if (value > max)
+			max = value;
+	}
+	
+	void PulseMeter::Statistic::Reset() {
+		count = 0;
+		min = UINT32_MAX;
+		max = 0;
+		sum = 0;
+	}
+	
+	uint8_t* PulseMeter::Statistic::Write(uint8_t* report) {
+		uint32_t values[] = {count > 0 ? min : 0, max, count > 0 ? (uint32_t) (sum / count) : 0};
+		*report++ = count;
+		*report++ = count >> 8;
+		for (uint8_t v = 0; v < 3; v++) {
+			*report++ = values[v];
+			*report++ = values[v] >> 8;
+			*report++ = values[v] >> 16;
+			*report++ = values[v] >> 24;
+		}
+		return report;
+	}
+}
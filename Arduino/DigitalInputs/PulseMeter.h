@@ -0,0 +1,79 @@
+/**
+ * @file PulseMeter.h
+ * @author Leonardo Molina (leonardomt@gmail.com).
+ * @date 2026-10-18
+ * @version 0.1.261018
+ * 
+ * @brief Measure high time, low time, and period of a digital signal from its edges.
+ */
+
+#ifndef BRIDGE_PULSEMETER_H
+#define BRIDGE_PULSEMETER_H
+
+#include <stdint.h>
+
+/// Size of a report (bytes).
+#define BRIDGE_PULSE_REPORT 42
+
+namespace bridge {
+	/**
+	 * @class PulseMeter
+	 * @brief Measure high time, low time, and period of a digital signal from its edges.
+	 * @details Keeps the count, minimum, maximum and mean of each measurement since the last report.
+	 * Intervals spanning missed edges are not measured.
+	 * 
+	 * Report layout (little-endian), for each of high time, low time, and period:
+	 *   uint16: count.
+	 *   uint32: minimum (us).
+	 *   uint32: maximum (us).
+	 *   uint32: mean (us).
+	 */
+	class PulseMeter {
+		public:
+			/// @brief Default constructor.
+			PulseMeter();
+			
+			/**
+			 * @brief Register an edge.
+			 * @param[in] state state following the edge.
+			 * @param[in] time time (us) of the edge.
+			 * @return void
+			 */
+			void Edge(bool state, uint32_t time);
+			
+			/**
+			 * @brief Register that edges were missed; the interval to the next edge is not measured.
+			 * @return void
+			 */
+			void Skip();
+			
+			/**
+			 * @brief Summarize measurements since the last report and restart them.
+			 * @param[out] report BRIDGE_PULSE_REPORT bytes.
+			 * @return void
+			 */
+			void Report(uint8_t* report);
+			
+		private:
+			/// @brief Running count, minimum, maximum and sum of a measurement.
+			struct Statistic {
+				uint16_t count;
+				uint32_t min;
+				uint32_t max;
+				uint64_t sum;
+				void Add(uint32_t value);
+				void Reset();
+				uint8_t* Write(uint8_t* report);
+			};
+			
+			Statistic high;					///< High time.
+			Statistic low;					///< Low time.
+			Statistic period;				///< Period, from rising edge to rising edge.
+			uint32_t riseTime;				///< Time (us) of the last rising edge.
+			uint32_t fallTime;				///< Time (us) of the last falling edge.
+			bool riseValid;					///< Whether riseTime may be used.
+			bool fallValid;					///< Whether fallTime may be used.
+	};
+}
+
+#endif
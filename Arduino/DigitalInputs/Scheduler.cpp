@@ -0,0 +1,109 @@
+/**
+ * @file Scheduler.cpp
+ * @author Leonardo Molina (leonardomt@gmail.com).
+ * @date 2026-10-18
+ * @version 0.1.261018
+ * 
+ * @brief Step Steppers at their own periods, most urgent first.
+ */
+
+#include <Arduino.h>
+#include "Monitor.h"
+#include "Scheduler.h"
+#include "tools.h"
+
+namespace bridge {
+	int8_t Scheduler::Add(Stepper* stepper, uint32_t period, uint8_t priority, uint32_t budget) {
+		if (nTasks == BRIDGE_MAX_TASKS)
+			return -1;
+		Task& task = tasks[nTasks];
+		task.stepper = stepper;
+		task.period = period;
+		task.priority = priority;
+		task.budget = budget;
+		task.release = micros();
+		task.overruns = 0;
+		task.misses = 0;
+		// Insert in order of priority, after tasks of equal priority.
+		uint8_t i = nTasks;
+		while (i > 0 && tasks[order[i - 1]].priority > priority) {
+			order[i] = order[i - 1];
+			i--;
+		}
+		order[i] = nTasks;
+		return nTasks++;
+	}
+	
+	void Scheduler::Step() {
+		// Periodic tasks due in this pass.
+		uint32_t now = micros();
+		uint16_t pending = 0;
+		for (uint8_t t = 0; t < nTasks; t++) {
+			if (tasks[t].period > 0 && (int32_t) (now - tasks[t].release) >= 0)
+				pending |= 1 << t;
+		}
+		RunEager();
+		// Earliest deadline first, then highest priority.
+		while (pending) {
+			int8_t best = -1;
+			int32_t bestSlack = 0;
+			for (uint8_t t = 0; t < nTasks; t++) {
+				if ((pending & (1 << t)) == 0)
+					continue;
+				int32_t slack = (int32_t) (tasks[t].release + tasks[t].period - now);
+				if (best < 0 || slack < bestSlack || (slack == bestSlack && tasks[t].priority < tasks[best].priority)) {
+					best = t;
+					bestSlack = slack;
+				}
+			}
+			pending &= ~(1 << best);
+			Run(tasks[best]);
+			// Service inputs between any two periodic tasks.
+			RunEager();
+		}
+	}
+	
+	void Scheduler::RunEager() {
+		for (uint8_t i = 0; i < nTasks; i++) {
+			Task& task = tasks[order[i]];
+			if (task.period == 0)
+				Run(task);
+		}
+	}
+	
+	void Scheduler::Run(Task& task) {
+		uint32_t start = micros();
+		uint32_t ticks = BRIDGE_TICKS();
+		task.stepper->Step();
+		uint32_t elapsed = (BRIDGE_TICKS() - ticks) / BRIDGE_TICKS_PER_US;
+		Monitor::OnStep(elapsed);
+		if (task.period == 0) {
+			task.release = start;
+		} else {
+			uint32_t deadline = task.release + task.period;
+			if ((int32_t) (start - deadline) >= 0) {
+				// Skip missed periods.
+				task.misses++;
+				task.release += ((start - task.release) / task.period) * task.period;
+			}
+			task.release += task.period;
+			if (task.budget > 0 && elapsed > task.budget) {
+				// Enforce the budget on average: postpone the next release in proportion to the excess.
+				task.overruns++;
+				task.release += (uint32_t) ((uint64_t) (elapsed - task.budget) * task.period / task.budget);
+			}
+		}
+	}
+	
+	uint8_t Scheduler::GetCount() {
+		return nTasks;
+	}
+	
+	uint32_t Scheduler::GetOverruns(uint8_t task) {
+		return task < nTasks ? tasks[task].overruns : 0;
+	}
+	
+	uint32_t Scheduler::GetMisses(uint8_t task) {
+		return task < nTasks ? tasks[task].misses : 0;
+	}
+}
@@ -0,0 +1,84 @@
+/**
+ * @file Scheduler.h
+ * @author Leonardo Molina (leonardomt@gmail.com).
+ * @date 2026-10-18
+ * @version 0.1.261018
+ * 
+ * @brief Step Steppers at their own periods, most urgent first.
+ */
+
+#ifndef BRIDGE_SCHEDULER_H
+#define BRIDGE_SCHEDULER_H
+
+#include <stdint.h>
+#include "Stepper.h"
+
+/// Maximum number of tasks.
+#define BRIDGE_MAX_TASKS 16
+
+namespace bridge {
+	/**
+	 * @class Scheduler
+	 * @brief Step Steppers at their own periods, most urgent first.
+	 * @details Every step of the scheduler is a pass over the periodic tasks that are due, each stepped once,
+	 * in order of deadline (the end of their current period) and then of priority. Tasks with a period of 0
+	 * (cheap, time-critical tasks such as digital inputs) are stepped in order of priority at the start of
+	 * the pass and again after every periodic task, so that within a pass they wait for at most one periodic
+	 * task. Steps cannot be preempted: work done outside the scheduler (e.g. the rest of loop) still delays
+	 * them by its full duration.
+	 * A task that takes longer than its budget counts an overrun and its next release is postponed in
+	 * proportion to the excess, so that on average it takes no more than budget / period of the time.
+	 * A task that starts after its deadline counts a miss and skips the periods missed.
+	 */
+	class Scheduler : public Stepper {
+		public:
+			/// @brief Default constructor.
+			Scheduler() : nTasks(0) {};
+			
+			/**
+			 * @brief Register a task.
+			 * @param[in] stepper object to step.
+			 * @param[in] period period (us) between steps; 0 steps in every pass.
+			 * @param[in] priority order among tasks with the same deadline; lower values first.
+			 * @param[in] budget maximum duration (us) of a step of a periodic task; 0 for none.
+			 * @return task index, or -1 if there are BRIDGE_MAX_TASKS tasks already.
+			 */
+			int8_t Add(Stepper* stepper, uint32_t period, uint8_t priority, uint32_t budget);
+			
+			/**
+			 * @brief Step every task that is due, most urgent first.
+			 * @return void
+			 */
+			void Step() override;
+			
+			/// @return number of tasks.
+			uint8_t GetCount();
+			
+			/// @return count of steps of a task that exceeded its budget.
+			uint32_t GetOverruns(uint8_t task);
+			
+			/// @return count of steps of a task that started after its deadline.
+			uint32_t GetMisses(uint8_t task);
+			
+		private:
+			/// @brief Task definition and statistics.
+			struct Task {
+				Stepper* stepper;
+				uint32_t period;
+				uint8_t priority;
+				uint32_t budget;
+				uint32_t release;
+				uint32_t overruns;
+				uint32_t misses;
+			};
+			
+			void Run(Task& task);						///< Step a task and update its statistics.
+			void RunEager();							///< Step every task with a period of 0, in order of priority.
+			
+			Task tasks[BRIDGE_MAX_TASKS];				///< Tasks.
+			uint8_t order[BRIDGE_MAX_TASKS];			///< Task indices in order of priority.
+			uint8_t nTasks;								///< Number of tasks.
+	};
+}
+
+#endif
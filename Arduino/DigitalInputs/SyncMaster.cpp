@@ -0,0 +1,48 @@
+/**
+ * @file SyncMaster.cpp
+ * @author Leonardo Molina (leonardomt@gmail.com).
+ * @date 2026-10-18
+ * @version 0.1.261018
+ * 
+ * @brief Emit periodic coded pulses to align the clocks of several boards.
+ */
+
+#include <Arduino.h>
+#include "SyncMaster.h"
+#include "tools.h"
+
+namespace bridge {
+	SyncMaster::SyncMaster(int8_t pin, uint32_t period, Function function) :
+	port(BRIDGE_BASEREG(pin)),
+	mask(BRIDGE_BITMASK(pin)),
+	function(function),
+	period(period * 1000),
+	code(0),
+	high(false)
+	{
+		// pinMode also selects the GPIO function of the pin (e.g. RP2040, Teensy); edges are written directly.
+		BRIDGE_WRITE_LOW(port, mask);
+		pinMode(pin, OUTPUT);
+		nextTime = micros() + this->period;
+	}
+	
+	void SyncMaster::Step() {
+		uint32_t now = micros();
+		if (high) {
+			if (now - riseTime >= (uint32_t) (code + 1) * BRIDGE_SYNC_UNIT) {
+				BRIDGE_WRITE_LOW(port, mask);
+				high = false;
+				code = (code + 1) % BRIDGE_SYNC_CODES;
+			}
+		} else if ((int32_t) (now - nextTime) >= 0) {
+			noInterrupts();
+			BRIDGE_WRITE_HIGH(port, mask);
+			riseTime = micros();
+			interrupts();
+			high = true;
+			// Keep a fixed period even if this step was late.
+			nextTime += period;
+			function(this, code, riseTime);
+		}
+	}
+}
@@ -0,0 +1,63 @@
+/**
+ * @file SyncMaster.h
+ * @author Leonardo Molina (leonardomt@gmail.com).
+ * @date 2026-10-18
+ * @version 0.1.261018
+ * 
+ * @brief Emit periodic coded pulses to align the clocks of several boards.
+ */
+
+#ifndef BRIDGE_SYNCMASTER_H
+#define BRIDGE_SYNCMASTER_H
+
+#include <stdint.h>
+#include "Stepper.h"
+#include "tools.h"
+
+/// Duration (us) of a unit of the pulse width code.
+#define BRIDGE_SYNC_UNIT 1000
+
+/// Number of distinct codes.
+#define BRIDGE_SYNC_CODES 8
+
+namespace bridge {
+	/**
+	 * @class SyncMaster
+	 * @brief Emit periodic coded pulses to align the clocks of several boards.
+	 * @details A pulse is emitted on an output pin every period, with a width of (code + 1) units, where
+	 * the code cycles from 0 to BRIDGE_SYNC_CODES - 1. The time of each rising edge is reported with its
+	 * code. Other boards timestamp the same pulses with a SyncSlave, so that a linear relation between
+	 * clocks can be fitted by the host, while codes guard against matching the wrong pulses.
+	 */
+	class SyncMaster : public Stepper {
+		public:
+			/// @typedef Function to invoke when a pulse starts.
+			typedef void (*Function) (SyncMaster* syncMaster, uint8_t code, uint32_t time);
+			
+			/**
+			 * @brief Emit coded pulses.
+			 * @param[in] pin GPIO number.
+			 * @param[in] period period (ms) between pulses.
+			 * @param[in] function function to invoke when a pulse starts.
+			 */
+			SyncMaster(int8_t pin, uint32_t period, Function function);
+			
+			/**
+			 * @brief Start and end pulses when due.
+			 * @return void
+			 */
+			void Step() override;
+			
+		private:
+			Port* port;				///< Hardware address of the pin.
+			Mask mask;						///< Mask to single out in the hardware address.
+			Function function;					///< Function invoked when a pulse starts.
+			uint32_t period;					///< Period (us) between pulses.
+			uint32_t nextTime;					///< Time (us) of the next pulse.
+			uint32_t riseTime;					///< Time (us) at which the current pulse started.
+			uint8_t code;						///< Code of the current pulse.
+			bool high;							///< Whether a pulse is ongoing.
+	};
+}
+
+#endif
@@ -0,0 +1,48 @@
+/**
+ * @file SyncSlave.cpp
+ * @author Leonardo Molina (leonardomt@gmail.com).
+ * @date 2026-10-18
+ * @version 0.1.261018
+ * 
+ * @brief Timestamp coded pulses emitted by a SyncMaster.
+ */
+
+#include <Arduino.h>
+#include "SyncMaster.h"
+#include "SyncSlave.h"
+
+namespace bridge {
+	SyncSlave::SyncSlave(int8_t pin, Function function) :
+	digitalInput(pin, OnChange, (DigitalInput::Data) this),
+	function(function),
+	started(false),
+	riseValid(false)
+	{
+	}
+	
+	void SyncSlave::Step() {
+		digitalInput.Step();
+	}
+	
+	void SyncSlave::OnChange(DigitalInput*, bool state, DigitalInput::Data data) {
+		// Forward static call to object.
+		((SyncSlave*) data)->OnChange(state);
+	}
+	
+	void SyncSlave::OnChange(bool state) {
+		uint32_t time = digitalInput.GetTime();
+		if (!started) {
+			// The initial state is not an edge.
+			started = true;
+		} else if (state) {
+			riseTime = time;
+			riseValid = true;
+		} else if (riseValid) {
+			// Decode the width to the nearest unit.
+			uint32_t units = (time - riseTime + BRIDGE_SYNC_UNIT / 2) / BRIDGE_SYNC_UNIT;
+			if (units >= 1 && units <= BRIDGE_SYNC_CODES)
+				function(this, units - 1, riseTime);
+			riseValid = false;
+		}
+	}
+}
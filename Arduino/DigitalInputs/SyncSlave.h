@@ -0,0 +1,55 @@
+/**
+ * @file SyncSlave.h
+ * @author Leonardo Molina (leonardomt@gmail.com).
+ * @date 2026-10-18
+ * @version 0.1.261018
+ * 
+ * @brief Timestamp coded pulses emitted by a SyncMaster.
+ */
+
+#ifndef BRIDGE_SYNCSLAVE_H
+#define BRIDGE_SYNCSLAVE_H
+
+#include <stdint.h>
+#include "DigitalInput.h"
+#include "Stepper.h"
+
+namespace bridge {
+	/**
+	 * @class SyncSlave
+	 * @brief Timestamp coded pulses emitted by a SyncMaster.
+	 * @details The rising edge of each pulse is timestamped by a DigitalInput and reported along with the
+	 * code decoded from the pulse width. Use a pin with a hardware interrupt, so that edges are timestamped
+	 * by the interrupt routine rather than at the next step.
+	 */
+	class SyncSlave : public Stepper {
+		public:
+			/// @typedef Function to invoke when a pulse ends.
+			typedef void (*Function) (SyncSlave* syncSlave, uint8_t code, uint32_t time);
+			
+			/**
+			 * @brief Timestamp coded pulses.
+			 * @param[in] pin GPIO number.
+			 * @param[in] function function to invoke when a pulse ends, with the time of its rising edge.
+			 */
+			SyncSlave(int8_t pin, Function function);
+			
+			/**
+			 * @brief Synchronize the digital input.
+			 * @return void
+			 */
+			void Step() override;
+			
+		private:
+			static void OnChange(DigitalInput* digitalInput, bool state, DigitalInput::Data data);	///< Forward changes to the object.
+			void OnChange(bool state);																///< Timestamp and decode pulses.
+			
+			DigitalInput digitalInput;			///< Input receiving pulses.
+			Function function;					///< Function invoked when a pulse ends.
+			bool started;						///< Whether the initial state was reported.
+			uint32_t riseTime;					///< Time (us) of the last rising edge.
+			bool riseValid;						///< Whether a rising edge was captured.
+	};
+}
+
+#endif
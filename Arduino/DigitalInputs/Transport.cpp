@@ -0,0 +1,60 @@
+/**
+ * @file Transport.cpp
+ * @author Leonardo Molina (leonardomt@gmail.com).
+ * @date 2026-10-18
+ * @version 0.1.261018
+ * 
+ * @brief Batch outgoing bytes into packets and describe the link to the host.
+ */
+
+#include <Arduino.h>
+#include "Monitor.h"
+#include "Transport.h"
+
+namespace bridge {
+	void Transport::Begin(uint32_t baudrate) {
+		this->baudrate = baudrate;
+		Serial.begin(baudrate);
+	}
+	
+	void Transport::Write(uint8_t value) {
+		if (nBuffer == BRIDGE_TRANSPORT_PACKET)
+			Flush();
+		buffer[nBuffer++] = value;
+	}
+	
+	void Transport::Write(const uint8_t* values, uint8_t length) {
+		if (nBuffer + length > BRIDGE_TRANSPORT_PACKET)
+			Flush();
+		if (length > BRIDGE_TRANSPORT_PACKET) {
+			Serial.write(values, length);
+		} else {
+			for (uint8_t i = 0; i < length; i++)
+				buffer[nBuffer++] = values[i];
+		}
+	}
+	
+	void Transport::Flush() {
+		if (nBuffer > 0) {
+			Serial.write(buffer, nBuffer);
+			nBuffer = 0;
+		}
+	}
+	
+	void Transport::Hello(uint8_t* report) {
+		uint8_t flags = 0;
+		#ifdef BRIDGE_NATIVE_USB
+		flags |= 1;
+		#endif
+		#ifdef BRIDGE_INSTRUMENT
+		flags |= 2;
+		#endif
+		report[0] = BRIDGE_TRANSPORT_VERSION;
+		report[1] = flags;
+		report[2] = baudrate;
+		report[3] = baudrate >> 8;
+		report[4] = baudrate >> 16;
+		report[5] = baudrate >> 24;
+		report[6] = BRIDGE_TRANSPORT_PACKET;
+	}
+}
@@ -0,0 +1,90 @@
+/**
+ * @file Transport.h
+ * @author Leonardo Molina (leonardomt@gmail.com).
+ * @date 2026-10-18
+ * @version 0.1.261018
+ * 
+ * @brief Batch outgoing bytes into packets and describe the link to the host.
+ */
+
+#ifndef BRIDGE_TRANSPORT_H
+#define BRIDGE_TRANSPORT_H
+
+#include <stdint.h>
+
+/// Size of a batch (bytes); the size of a full-speed USB bulk packet.
+#define BRIDGE_TRANSPORT_PACKET 64
+
+/// Size of a hello report (bytes).
+#define BRIDGE_TRANSPORT_HELLO 7
+
+/// Version of the serial protocol, reported in hello.
+#define BRIDGE_TRANSPORT_VERSION 1
+
+/// Serial is a native USB (CDC) port, for which the baudrate is irrelevant. Define for other such boards.
+#if defined(USBCON) || defined(CORE_TEENSY) || defined(ARDUINO_ARCH_RP2040) || defined(ARDUINO_ARCH_MBED)
+#define BRIDGE_NATIVE_USB
+#endif
+
+namespace bridge {
+	/**
+	 * @class Transport
+	 * @brief Batch outgoing bytes into packets and describe the link to the host.
+	 * @details Bytes are queued and handed to Serial in batches of up to BRIDGE_TRANSPORT_PACKET bytes, when
+	 * a batch is full or when flushed, normally once per loop. With native USB, each write may otherwise
+	 * become a USB packet of its own; with a UART, batches cost one call instead of one per byte.
+	 *
+	 * Hello layout (little-endian):
+	 *   uint8: protocol version.
+	 *   uint8: flags; bit 1: native USB, bit 2: BRIDGE_INSTRUMENT.
+	 *   uint32: baudrate.
+	 *   uint8: batch size (bytes).
+	 */
+	class Transport {
+		public:
+			/// @brief Default constructor.
+			Transport() : baudrate(0), nBuffer(0) {};
+			
+			/**
+			 * @brief Open the serial port.
+			 * @param[in] baudrate bits per second of a UART, e.g. 115200, 1000000 or 2000000.
+			 * @return void
+			 */
+			void Begin(uint32_t baudrate);
+			
+			/**
+			 * @brief Queue a byte.
+			 * @param[in] value byte to send.
+			 * @return void
+			 */
+			void Write(uint8_t value);
+			
+			/**
+			 * @brief Queue bytes.
+			 * @param[in] values bytes to send.
+			 * @param[in] length number of bytes.
+			 * @return void
+			 */
+			void Write(const uint8_t* values, uint8_t length);
+			
+			/**
+			 * @brief Hand queued bytes to Serial.
+			 * @return void
+			 */
+			void Flush();
+			
+			/**
+			 * @brief Describe the link, in reply to a hello from the host.
+			 * @param[out] report BRIDGE_TRANSPORT_HELLO bytes.
+			 * @return void
+			 */
+			void Hello(uint8_t* report);
+		
+		private:
+			uint32_t baudrate;								///< Bits per second.
+			uint8_t buffer[BRIDGE_TRANSPORT_PACKET];		///< Bytes queued.
+			uint8_t nBuffer;								///< Number of bytes queued.
+	};
+}
+
+#endif
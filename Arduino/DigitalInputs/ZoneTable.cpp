@@ -0,0 +1,96 @@
+/**
+ * @file ZoneTable.cpp
+ * @author Leonardo Molina (leonardomt@gmail.com).
+ * @date 2026-10-18
+ * @version 0.1.261018
+ * 
+ * @brief Test positions against zones and drive digital outputs on entry and exit.
+ */
+
+#include <Arduino.h>
+#include "ZoneTable.h"
+#include "tools.h"
+
+namespace bridge {
+	ZoneTable::ZoneTable(Function function) :
+	function(function)
+	{
+		for (uint8_t z = 0; z < BRIDGE_MAX_ZONES; z++) {
+			zones[z].shape = None;
+			zones[z].output = false;
+			zones[z].state = false;
+		}
+	}
+	
+	bool ZoneTable::Set(uint8_t zone, Shape shape, int8_t pin, const int16_t* parameters) {
+		if (zone >= BRIDGE_MAX_ZONES || shape > Rectangle)
+			return false;
+		Zone& target = zones[zone];
+		// Release the previous output.
+		Write(target, false);
+		target.shape = None;
+		target.state = false;
+		if (shape == Circle && parameters[2] < 0)
+			return false;
+		for (uint8_t p = 0; p < 4; p++)
+			target.parameters[p] = parameters[p];
+		if (shape == Rectangle) {
+			// Sort corners.
+			if (target.parameters[0] > target.parameters[2]) {
+				target.parameters[0] = parameters[2];
+				target.parameters[2] = parameters[0];
+			}
+			if (target.parameters[1] > target.parameters[3]) {
+				target.parameters[1] = parameters[3];
+				target.parameters[3] = parameters[1];
+			}
+		}
+		target.output = pin >= 0;
+		if (target.output) {
+			target.port = BRIDGE_BASEREG(pin);
+			target.mask = BRIDGE_BITMASK(pin);
+			BRIDGE_WRITE_LOW(target.port, target.mask);
+			pinMode(pin, OUTPUT);
+		}
+		target.shape = shape;
+		return true;
+	}
+	
+	void ZoneTable::Update(int16_t x, int16_t y) {
+		for (uint8_t z = 0; z < BRIDGE_MAX_ZONES; z++) {
+			Zone& zone = zones[z];
+			if (zone.shape == None)
+				continue;
+			bool state = x != BRIDGE_ZONE_NONE && Inside(zone, x, y);
+			if (state != zone.state) {
+				Write(zone, state);
+				zone.state = state;
+				function(this, z, state);
+			}
+		}
+	}
+	
+	bool ZoneTable::Inside(const Zone& zone, int16_t x, int16_t y) {
+		const int16_t* p = zone.parameters;
+		if (zone.shape == Circle) {
+			int32_t dx = (int32_t) x - p[0];
+			int32_t dy = (int32_t) y - p[1];
+			int32_t r = p[2];
+			// Reject early; otherwise squares fit in 32 bits.
+			if (dx > r || dx < -r || dy > r || dy < -r)
+				return false;
+			return (uint32_t) (dx * dx) + (uint32_t) (dy * dy) <= (uint32_t) (r * r);
+		} else {
+			return x >= p[0] && x <= p[2] && y >= p[1] && y <= p[3];
+		}
+	}
+	
+	void ZoneTable::Write(Zone& zone, bool state) {
+		if (!zone.output)
+			return;
+		if (state)
+			BRIDGE_WRITE_HIGH(zone.port, zone.mask);
+		else
+			BRIDGE_WRITE_LOW(zone.port, zone.mask);
+	}
+}
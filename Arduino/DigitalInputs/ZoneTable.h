@@ -0,0 +1,88 @@
+/**
+ * @file ZoneTable.h
+ * @author Leonardo Molina (leonardomt@gmail.com).
+ * @date 2026-10-18
+ * @version 0.1.261018
+ * 
+ * @brief Test positions against zones and drive digital outputs on entry and exit.
+ */
+
+#ifndef BRIDGE_ZONETABLE_H
+#define BRIDGE_ZONETABLE_H
+
+#include <stdint.h>
+#include "tools.h"
+
+/// Maximum number of zones.
+#define BRIDGE_MAX_ZONES 8
+
+/// Fixed point unit: coordinates are multiplied by this number.
+#define BRIDGE_ZONE_UNIT 16384
+
+/// Coordinate indicating that a position is not available.
+#define BRIDGE_ZONE_NONE INT16_MIN
+
+namespace bridge {
+	/**
+	 * @class ZoneTable
+	 * @brief Test positions against zones and drive digital outputs on entry and exit.
+	 * @details Zones are circles or rectangles in fixed point (Q2.14, i.e. coordinates in [-2, 2) multiplied
+	 * by BRIDGE_ZONE_UNIT). Each zone may drive an output pin, set high while the position is inside the zone.
+	 * Outputs change as soon as a position is tested, and the change is then reported.
+	 */
+	class ZoneTable {
+		public:
+			/// @typedef Function to invoke when a position enters or exits a zone.
+			typedef void (*Function) (ZoneTable* zoneTable, uint8_t zone, bool state);
+			
+			/// @brief Zone shapes.
+			enum Shape : uint8_t {
+				None = 0,		///< Zone is disabled.
+				Circle = 1,		///< Parameters are x, y and radius.
+				Rectangle = 2	///< Parameters are x1, y1, x2, y2 of two opposite corners.
+			};
+			
+			/**
+			 * @brief Create an empty table.
+			 * @param[in] function function to invoke when a position enters or exits a zone.
+			 */
+			ZoneTable(Function function);
+			
+			/**
+			 * @brief Set or clear a zone. The output of a zone being replaced is set low.
+			 * @param[in] zone zone index, from 0 to BRIDGE_MAX_ZONES - 1.
+			 * @param[in] shape zone shape.
+			 * @param[in] pin output GPIO number, or -1 for none.
+			 * @param[in] parameters 3 (circle) or 4 (rectangle) fixed point parameters.
+			 * @return whether the zone is valid.
+			 */
+			bool Set(uint8_t zone, Shape shape, int8_t pin, const int16_t* parameters);
+			
+			/**
+			 * @brief Test a position against every zone, drive outputs and report changes.
+			 * @param[in] x fixed point coordinate, or BRIDGE_ZONE_NONE if there is no position.
+			 * @param[in] y fixed point coordinate.
+			 * @return void
+			 */
+			void Update(int16_t x, int16_t y);
+			
+		private:
+			/// @brief Zone definition and state.
+			struct Zone {
+				Shape shape;
+				int16_t parameters[4];
+				bool output;
+				Port* port;
+				Mask mask;
+				bool state;
+			};
+			
+			bool Inside(const Zone& zone, int16_t x, int16_t y);		///< Test a position against a zone.
+			void Write(Zone& zone, bool state);							///< Drive the output of a zone.
+			
+			Function function;											///< Function invoked on entry and exit.
+			Zone zones[BRIDGE_MAX_ZONES];								///< Zones.
+	};
+}
+
+#endif
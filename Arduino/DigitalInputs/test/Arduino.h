@@ -0,0 +1,25 @@
+/**
+ * @file Arduino.h
+ * @author Leonardo Molina (leonardomt@gmail.com).
+ * @date 2026-10-18
+ * @version 0.1.261018
+ * 
+ * @brief Minimal host stand-in for the Arduino core, enough to include tools.h.
+ */
+
+#ifndef BRIDGE_TEST_ARDUINO_H
+#define BRIDGE_TEST_ARDUINO_H
+
+#include <stdint.h>
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return LOW; }
+inline unsigned long micros() { return 0; }
+
+#endif
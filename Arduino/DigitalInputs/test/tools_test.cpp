@@ -0,0 +1,138 @@
+/**
+ * @file tools_test.cpp
+ * @author Leonardo Molina (leonardomt@gmail.com).
+ * @date 2026-10-18
+ * @version 0.1.261018
+ * 
+ * @brief Check the registers written by the port macros of tools.h, on the host.
+ * @details Build once per architecture, defining the macro that selects its branch (see Makefile). Each
+ * port is laid out as a fake register file following the memory map of the target, and every macro is
+ * checked to write the intended register, and only that register.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "tools.h"
+
+#ifndef BRIDGE_FAST_IO
+#error No fast IO branch selected.
+#endif
+
+static int failures = 0;
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			printf("%s:%d: %s\n", __FILE__, __LINE__, #condition); \
+			failures++; \
+		} \
+	} while (0)
+
+#if defined(ARDUINO_ARCH_MEGAAVR)
+	#define ARCH "megaAVR"
+	/// PORT_t: DIR, DIRSET, DIRCLR, DIRTGL, OUT, OUTSET, OUTCLR, OUTTGL, IN.
+	enum {DIR, DIRSET, DIRCLR, DIRTGL, OUT, OUTSET, OUTCLR, OUTTGL, IN, SIZE = 16};
+	#define INPUT_REG IN
+	#define MASK 0x10
+#elif defined(__AVR__)
+	#define ARCH "AVR"
+	/// PINx, DDRx, PORTx.
+	enum {PIN, DDR, PORT, SIZE = 3};
+	#define INPUT_REG PIN
+	#define MASK 0x10
+#elif defined(ARDUINO_ARCH_SAMD)
+	#define ARCH "SAMD"
+	/// PortGroup, in words: DIR, DIRCLR, DIRSET, DIRTGL, OUT, OUTCLR, OUTSET, OUTTGL, IN.
+	enum {DIR, DIRCLR, DIRSET, DIRTGL, OUT, OUTCLR, OUTSET, OUTTGL, IN, SIZE = 32};
+	#define INPUT_REG IN
+	#define MASK 0x10000
+#elif defined(KINETISK)
+	#define ARCH "Teensy 3.x"
+	/// Bit-band aliases of GPIO PDOR, PSOR, PCOR, PTOR, PDIR, PDDR: one word per bit, 32 words per register.
+	enum {BIT = 5};
+	enum {PSOR = 1 * 32 + BIT, PCOR = 2 * 32 + BIT, PDIR = 4 * 32 + BIT, PDDR = 5 * 32 + BIT, SIZE = 6 * 32};
+	#define INPUT_REG PDIR
+	#define MASK 1
+#elif defined(__IMXRT1062__)
+	#define ARCH "Teensy 4.x"
+	/// GPIO, in words: DR, GDIR, PSR, ..., DR_SET (0x84), DR_CLEAR (0x88), DR_TOGGLE (0x8C).
+	enum {DR = 0, GDIR = 1, PSR = 2, DR_SET = 33, DR_CLEAR = 34, DR_TOGGLE = 35, SIZE = 36};
+	#define INPUT_REG PSR
+	#define MASK 0x10000
+#elif defined(ARDUINO_ARCH_RP2040) || defined(ARDUINO_ARCH_MBED_RP2040)
+	#define ARCH "RP2040"
+	/// SIO, in words: CPUID, GPIO_IN, GPIO_HI_IN, -, GPIO_OUT, GPIO_OUT_SET, GPIO_OUT_CLR, GPIO_OUT_XOR,
+	/// GPIO_OE, GPIO_OE_SET, GPIO_OE_CLR.
+	enum {GPIO_IN = 1, GPIO_OUT_SET = 5, GPIO_OUT_CLR = 6, GPIO_OE = 8, GPIO_OE_SET = 9, GPIO_OE_CLR = 10, SIZE = 16};
+	#define INPUT_REG GPIO_IN
+	#define MASK 0x10000
+#endif
+
+static bridge::Mask registers[SIZE];
+static bridge::Mask expected[SIZE];
+static bridge::Port* const base = (bridge::Port*) registers + INPUT_REG;
+
+/// Reset the register file and the expectation to the same values.
+static void Reset(bridge::Mask value) {
+	for (int r = 0; r < SIZE; r++)
+		registers[r] = expected[r] = value;
+}
+
+/// Check that the register file holds the expectation.
+static void Compare(const char* name) {
+	for (int r = 0; r < SIZE; r++) {
+		if (registers[r] != expected[r]) {
+			printf("%s %s: register %d is 0x%lx, expected 0x%lx\n", ARCH, name, r, (unsigned long) registers[r], (unsigned long) expected[r]);
+			failures++;
+		}
+	}
+}
+
+int main() {
+	const bridge::Mask mask = MASK;
+	
+	#if defined(ARDUINO_ARCH_MEGAAVR)
+	Reset(0); expected[DIRCLR] = mask; BRIDGE_MAKE_INPUT(base, mask); Compare("make input");
+	Reset(0); expected[DIRSET] = mask; BRIDGE_MAKE_OUTPUT(base, mask); Compare("make output");
+	Reset(0); expected[OUTCLR] = mask; BRIDGE_WRITE_LOW(base, mask); Compare("write low");
+	Reset(0); expected[OUTSET] = mask; BRIDGE_WRITE_HIGH(base, mask); Compare("write high");
+	#elif defined(__AVR__)
+	Reset(0xff); expected[DDR] = expected[PORT] = 0xff & ~mask; BRIDGE_MAKE_INPUT(base, mask); Compare("make input");
+	Reset(0); expected[DDR] = mask; BRIDGE_MAKE_OUTPUT(base, mask); Compare("make output");
+	Reset(0xff); expected[PORT] = 0xff & ~mask; BRIDGE_WRITE_LOW(base, mask); Compare("write low");
+	Reset(0); expected[PORT] = mask; BRIDGE_WRITE_HIGH(base, mask); Compare("write high");
+	#elif defined(ARDUINO_ARCH_SAMD)
+	Reset(0); expected[DIRCLR] = mask; BRIDGE_MAKE_INPUT(base, mask); Compare("make input");
+	Reset(0); expected[DIRSET] = mask; BRIDGE_MAKE_OUTPUT(base, mask); Compare("make output");
+	Reset(0); expected[OUTCLR] = mask; BRIDGE_WRITE_LOW(base, mask); Compare("write low");
+	Reset(0); expected[OUTSET] = mask; BRIDGE_WRITE_HIGH(base, mask); Compare("write high");
+	#elif defined(KINETISK)
+	Reset(1); expected[PDDR] = 0; BRIDGE_MAKE_INPUT(base, mask); Compare("make input");
+	Reset(0); expected[PDDR] = 1; BRIDGE_MAKE_OUTPUT(base, mask); Compare("make output");
+	Reset(0); expected[PCOR] = 1; BRIDGE_WRITE_LOW(base, mask); Compare("write low");
+	Reset(0); expected[PSOR] = 1; BRIDGE_WRITE_HIGH(base, mask); Compare("write high");
+	#elif defined(__IMXRT1062__)
+	Reset(0xffffffff); expected[GDIR] = ~mask; BRIDGE_MAKE_INPUT(base, mask); Compare("make input");
+	Reset(0); expected[GDIR] = mask; BRIDGE_MAKE_OUTPUT(base, mask); Compare("make output");
+	Reset(0); expected[DR_CLEAR] = mask; BRIDGE_WRITE_LOW(base, mask); Compare("write low");
+	Reset(0); expected[DR_SET] = mask; BRIDGE_WRITE_HIGH(base, mask); Compare("write high");
+	#elif defined(ARDUINO_ARCH_RP2040) || defined(ARDUINO_ARCH_MBED_RP2040)
+	CHECK((uintptr_t) BRIDGE_BASEREG(16) == 0xd0000004);
+	CHECK(BRIDGE_BITMASK(16) == mask);
+	Reset(0); expected[GPIO_OE_CLR] = mask; BRIDGE_MAKE_INPUT(base, mask); Compare("make input");
+	Reset(0); expected[GPIO_OE_SET] = mask; BRIDGE_MAKE_OUTPUT(base, mask); Compare("make output");
+	Reset(0); expected[GPIO_OUT_CLR] = mask; BRIDGE_WRITE_LOW(base, mask); Compare("write low");
+	Reset(0); expected[GPIO_OUT_SET] = mask; BRIDGE_WRITE_HIGH(base, mask); Compare("write high");
+	#endif
+	
+	// Reads come from the input register.
+	Reset(0);
+	registers[INPUT_REG] = mask;
+	CHECK(BRIDGE_READ(base, mask) == 1);
+	CHECK(BRIDGE_READ_PORT(base) == mask);
+	registers[INPUT_REG] = 0;
+	CHECK(BRIDGE_READ(base, mask) == 0);
+	
+	printf("%s: %s\n", ARCH, failures == 0 ? "ok" : "failed");
+	return failures == 0 ? 0 : 1;
+}
@@ -2,36 +2,163 @@
  * @file tools.h
  * @author Leonardo Molina (leonardomt@gmail.com).
  * @date 2016-12-03
- * @version 0.1.180714
- * 
+ * @version 0.1.261018
+ *
  * @brief Tools for direct port manipulation.
  * Macros provided are faster analogous to pinMode, digitalRead, and digitalWrite.
+ *
+ * A pin is addressed by the input register of its port (base) and a mask singling it out. Other
+ * registers of the port are found at fixed offsets from base, which depend on the architecture:
+ *   AVR:             PIN, DDR, PORT.
+ *   megaAVR:         PORT DIRSET, DIRCLR, OUTSET, OUTCLR, IN.
+ *   SAMD21/SAMD51:   PORT group DIRCLR, DIRSET, OUTCLR, OUTSET, IN.
+ *   Teensy 3.x:      bit-band aliases of PDIR, PDDR, PSOR, PCOR; one word per pin, mask is 1.
+ *   Teensy 4.x:      GPIO PSR, GDIR, DR_SET, DR_CLEAR.
+ *   RP2040:          SIO GPIO_IN, GPIO_OUT_SET, GPIO_OUT_CLR, GPIO_OE_SET, GPIO_OE_CLR.
+ * On megaAVR and ARM, writes go through set and clear registers and are therefore atomic.
+ * BRIDGE_MAKE_INPUT and BRIDGE_MAKE_OUTPUT only change the direction of a pin; configure pins with
+ * pinMode first, which also routes them to the GPIO block (e.g. FUNCSEL on RP2040, the pin mux on Teensy).
+ * test/tools_test.cpp checks the register each macro writes against a fake register file ("make -C test").
+ * Only the AVR branch has run on hardware; the others follow the register maps of each core.
+ * Other architectures fall back to pinMode, digitalRead, and digitalWrite, with the pin number in
+ * place of the mask; BRIDGE_FAST_IO is left undefined, so that ports are not read as a whole.
+ *
+ * BRIDGE_TICKS returns a free-running counter to measure short durations (it may wrap within seconds):
+ *   Cortex-M3/M4/M7/M33 (SAMD51, Teensy 3.x/4.x, RP2350): DWT cycle counter.
+ *   RP2040: 1 MHz system timer.
+ *   Others (AVR, SAMD21): micros.
 **/
- 
+
 #ifndef BRIDGE_TOOLS_H
 #define BRIDGE_TOOLS_H
 
 #include <Arduino.h>
 
-/// Get hardware address containing pin.
-#define BRIDGE_BASEREG(pin)		 		   portInputRegister(digitalPinToPort(pin))
-
-/// Get mask isolating a pin from its port.
-#define BRIDGE_BITMASK(pin)		 		   digitalPinToBitMask(pin)
-
-/// Change pin mode to binary input (direct port manipulation).
-#define BRIDGE_MAKE_INPUT(base, mask)	 *(base + 1) &= ~mask, *(base + 2) &= ~mask
+/// Register type (Port) and pin mask type (Mask) of each architecture, and the number of pins per port.
+#if defined(ARDUINO_ARCH_MEGAAVR)
+	#define BRIDGE_FAST_IO
+	namespace bridge {
+		typedef volatile uint8_t Port;
+		typedef uint8_t Mask;
+	}
+	#define BRIDGE_PORT_WIDTH					8
+	#define BRIDGE_BASEREG(pin)					portInputRegister(digitalPinToPort(pin))
+	#define BRIDGE_BITMASK(pin)					digitalPinToBitMask(pin)
+	#define BRIDGE_MAKE_INPUT(base, mask)		(*(base - 6) = (mask))
+	#define BRIDGE_MAKE_OUTPUT(base, mask)		(*(base - 7) = (mask))
+	#define BRIDGE_WRITE_LOW(base, mask)		(*(base - 2) = (mask))
+	#define BRIDGE_WRITE_HIGH(base, mask)		(*(base - 3) = (mask))
+#elif defined(__AVR__)
+	#define BRIDGE_FAST_IO
+	namespace bridge {
+		typedef volatile uint8_t Port;
+		typedef uint8_t Mask;
+	}
+	#define BRIDGE_PORT_WIDTH					8
+	#define BRIDGE_BASEREG(pin)					portInputRegister(digitalPinToPort(pin))
+	#define BRIDGE_BITMASK(pin)					digitalPinToBitMask(pin)
+	#define BRIDGE_MAKE_INPUT(base, mask)		(*(base + 1) &= ~(mask), *(base + 2) &= ~(mask))
+	#define BRIDGE_MAKE_OUTPUT(base, mask)		(*(base + 1) |=  (mask))
+	#define BRIDGE_WRITE_LOW(base, mask)		(*(base + 2) &= ~(mask))
+	#define BRIDGE_WRITE_HIGH(base, mask)		(*(base + 2) |=  (mask))
+#elif defined(ARDUINO_ARCH_SAMD)
+	#define BRIDGE_FAST_IO
+	namespace bridge {
+		typedef volatile uint32_t Port;
+		typedef uint32_t Mask;
+	}
+	#define BRIDGE_PORT_WIDTH					32
+	#define BRIDGE_BASEREG(pin)					portInputRegister(digitalPinToPort(pin))
+	#define BRIDGE_BITMASK(pin)					digitalPinToBitMask(pin)
+	#define BRIDGE_MAKE_INPUT(base, mask)		(*(base - 7) = (mask))
+	#define BRIDGE_MAKE_OUTPUT(base, mask)		(*(base - 6) = (mask))
+	#define BRIDGE_WRITE_LOW(base, mask)		(*(base - 3) = (mask))
+	#define BRIDGE_WRITE_HIGH(base, mask)		(*(base - 2) = (mask))
+#elif defined(KINETISK)
+	#define BRIDGE_FAST_IO
+	namespace bridge {
+		typedef volatile uint32_t Port;
+		typedef uint32_t Mask;
+	}
+	#define BRIDGE_PORT_WIDTH					32
+	#define BRIDGE_BASEREG(pin)					((volatile uint32_t*) portInputRegister(pin))
+	#define BRIDGE_BITMASK(pin)					1
+	#define BRIDGE_MAKE_INPUT(base, mask)		(*(base + 32) = 0)
+	#define BRIDGE_MAKE_OUTPUT(base, mask)		(*(base + 32) = 1)
+	#define BRIDGE_WRITE_LOW(base, mask)		(*(base - 64) = 1)
+	#define BRIDGE_WRITE_HIGH(base, mask)		(*(base - 96) = 1)
+#elif defined(__IMXRT1062__)
+	#define BRIDGE_FAST_IO
+	namespace bridge {
+		typedef volatile uint32_t Port;
+		typedef uint32_t Mask;
+	}
+	#define BRIDGE_PORT_WIDTH					32
+	#define BRIDGE_BASEREG(pin)					portInputRegister(pin)
+	#define BRIDGE_BITMASK(pin)					digitalPinToBitMask(pin)
+	#define BRIDGE_MAKE_INPUT(base, mask)		(*(base - 1) &= ~(mask))
+	#define BRIDGE_MAKE_OUTPUT(base, mask)		(*(base - 1) |=  (mask))
+	#define BRIDGE_WRITE_LOW(base, mask)		(*(base + 32) = (mask))
+	#define BRIDGE_WRITE_HIGH(base, mask)		(*(base + 31) = (mask))
+#elif (defined(ARDUINO_ARCH_RP2040) && !defined(PICO_RP2350)) || defined(ARDUINO_ARCH_MBED_RP2040)
+	#define BRIDGE_FAST_IO
+	namespace bridge {
+		typedef volatile uint32_t Port;
+		typedef uint32_t Mask;
+	}
+	#define BRIDGE_PORT_WIDTH					32
+	/// SIO GPIO_IN; a single port holds all pins.
+	#define BRIDGE_BASEREG(pin)					((volatile uint32_t*) 0xd0000004)
+	#define BRIDGE_BITMASK(pin)					(1ul << (pin))
+	#define BRIDGE_MAKE_INPUT(base, mask)		(*(base + 9) = (mask))
+	#define BRIDGE_MAKE_OUTPUT(base, mask)		(*(base + 8) = (mask))
+	#define BRIDGE_WRITE_LOW(base, mask)		(*(base + 5) = (mask))
+	#define BRIDGE_WRITE_HIGH(base, mask)		(*(base + 4) = (mask))
+#else
+	namespace bridge {
+		typedef volatile uint8_t Port;
+		typedef uint8_t Mask;
+	}
+	#define BRIDGE_PORT_WIDTH					8
+	#define BRIDGE_BASEREG(pin)					((bridge::Port*) nullptr)
+	#define BRIDGE_BITMASK(pin)					(pin)
+	#define BRIDGE_MAKE_INPUT(base, mask)		pinMode(mask, INPUT)
+	#define BRIDGE_MAKE_OUTPUT(base, mask)		pinMode(mask, OUTPUT)
+	#define BRIDGE_WRITE_LOW(base, mask)		digitalWrite(mask, LOW)
+	#define BRIDGE_WRITE_HIGH(base, mask)		digitalWrite(mask, HIGH)
+	#define BRIDGE_READ(base, mask)				(digitalRead(mask) == HIGH)
+#endif
 
-/// Change pin mode to binary output (direct port manipulation).
-#define BRIDGE_MAKE_OUTPUT(base, mask)	 *(base + 1) |=  mask
+/// Read pin binary state (direct port manipulation).
+#ifndef BRIDGE_READ
+#define BRIDGE_READ(base, mask)					((*(base) & (mask)) ? 1 : 0)
+#endif
 
-/// Set pin state to low (direct port manipulation).
-#define BRIDGE_WRITE_LOW(base, mask)	 *(base + 2) &= ~mask
+/// Read all pins of a port at once.
+#define BRIDGE_READ_PORT(base)					(*(base))
 
-/// Set pin state to high (direct port manipulation).
-#define BRIDGE_WRITE_HIGH(base, mask)	 *(base + 2) |=  mask
+/// Interrupt number of a pin, or a negative value if changes to the pin cannot trigger an interrupt.
+#if defined(ARDUINO_ARCH_SAMD)
+	// Pins without an external interrupt line are still given a number by digitalPinToInterrupt.
+	#define BRIDGE_INTERRUPT(pin)				(g_APinDescription[pin].ulExtInt == NOT_AN_INTERRUPT ? -1 : digitalPinToInterrupt(pin))
+#else
+	#define BRIDGE_INTERRUPT(pin)				digitalPinToInterrupt(pin)
+#endif
 
-/// Read pin binary state (direct port manipulation).
-#define BRIDGE_READ(base, mask)			(*(base + 0) &   mask) ? 1 : 0
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+	#define BRIDGE_TICKS_PER_US					(F_CPU / 1000000ul)
+	/// Enable the DWT cycle counter (DEMCR.TRCENA, then DWT_CTRL.CYCCNTENA).
+	#define BRIDGE_TICKS_BEGIN()				((*(volatile uint32_t*) 0xE000EDFC) |= 1ul << 24, (*(volatile uint32_t*) 0xE0001000) |= 1ul)
+	#define BRIDGE_TICKS()						(*(volatile uint32_t*) 0xE0001004)
+#elif defined(ARDUINO_ARCH_RP2040) || defined(ARDUINO_ARCH_MBED_RP2040)
+	#define BRIDGE_TICKS_PER_US					1
+	#define BRIDGE_TICKS_BEGIN()				((void) 0)
+	/// TIMERAWL, the low word of the 1 MHz system timer.
+	#define BRIDGE_TICKS()						(*(volatile uint32_t*) 0x40054028)
+#else
+	#define BRIDGE_TICKS_PER_US					1
+	#define BRIDGE_TICKS_BEGIN()				((void) 0)
+	#define BRIDGE_TICKS()						micros()
+#endif
 
-#endif
\ No newline at end of file
+#endif
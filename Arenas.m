@@ -0,0 +1,156 @@
+% Arenas - Run several arenas from a single MATLAB session.
+% Each arena has its own camera, tracker, zones and log files (and serial
+% device, when synchronized with TrackerSync), but all cameras are driven by
+% one shared loop that visits arenas in turn, so that a busy arena cannot
+% starve the others and the cost of a MATLAB process is paid once.
+%
+% Arenas methods:
+%   delete - Stop all arenas and release their resources.
+%
+% Arenas properties:
+%   arenas - VirtualTracker.GUI handle of each arena.
+%   counts - Number of frames processed by each arena (NaN once closed).
+%   period - Period (s) of the shared loop.
+%   play   - Start/stop video acquisition in all arenas.
+%   syncs  - TrackerSync handle of each arena, if any.
+%
+% In every iteration of the loop, each camera is polled once, starting with
+% a different arena every time. Log files of arenas started within the same
+% second are told apart with a numeric suffix. Synchronized arenas save their
+% settings to TrackerSync.arena<a>.settings.mat, one file per arena.
+%
+% Example 1 - four cameras:
+%   arenas = Arenas({1, 2, 3, 4});
+%   arenas.arenas{1}.zones = {1, [0, 0, 0.1], @(data)fprintf('Arena 1: %i\n', data.State)};
+%   arenas.play = true;
+%
+% Example 2 - four cameras synchronized with four serial devices:
+%   arenas = Arenas({1, 2, 3, 4}, {'COM3', 'COM4', 'COM5', 'COM6'});
+%   arenas.play = true;
+%
+% MATLAB runs all callbacks in a single thread, so arenas cannot be pinned
+% to cores; built-in functions used by the tracker share the computational
+% threads given by maxNumCompThreads.
+%
+% See also VirtualTracker.GUI, TrackerSync, Camera.step.
+
+% 2026-10-18. Leonardo Molina.
+% 2026-10-18. Last modified.
+classdef Arenas < handle
+    properties (Dependent)
+        % counts - Number of frames processed by each arena.
+        counts
+        
+        % period - Period (s) of the shared loop.
+        period
+        
+        % play - Start/stop video acquisition in all arenas.
+        play
+    end
+    
+    properties (SetAccess = private)
+        % arenas - VirtualTracker.GUI handle of each arena.
+        arenas = {}
+        
+        % syncs - TrackerSync handle of each arena, if any.
+        syncs = {}
+    end
+    
+    properties (Access = private)
+        first = 1
+        loopHandle
+        mPeriod = 2e-3
+        mPlay = false
+    end
+    
+    methods
+        function obj = Arenas(cameraIds, comIds)
+            % Arenas(cameraIds, <comIds>)
+            % Create one arena per camera id (or camera backend). When a
+            % list of serial ports is given, arenas are created with
+            % TrackerSync, one serial port per camera.
+            
+            nArenas = numel(cameraIds);
+            if nargin == 2 && numel(comIds) ~= nArenas
+                error('Value provided for comIds is invalid.');
+            end
+            for a = 1:nArenas
+                if nargin == 2
+                    % Each arena keeps its own GUI settings.
+                    obj.syncs{a} = TrackerSync(comIds{a}, cameraIds{a}, sprintf('TrackerSync.arena%i.settings.mat', a));
+                    obj.arenas{a} = obj.syncs{a}.virtualTracker;
+                else
+                    obj.arenas{a} = VirtualTracker.GUI(cameraIds{a});
+                end
+                obj.arenas{a}.camera.external = true;
+                obj.arenas{a}.window.Name = sprintf('%s - Arena %i', obj.arenas{a}.window.Name, a);
+            end
+            obj.loopHandle = Scheduler.Repeat(@obj.loop, obj.period);
+        end
+        
+        function delete(obj)
+            % Arenas.delete()
+            % Stop all arenas and release their resources.
+            
+            Objects.delete(obj.loopHandle);
+            if isempty(obj.syncs)
+                Objects.delete(obj.arenas{:});
+            else
+                Objects.delete(obj.syncs{:});
+            end
+        end
+        
+        function counts = get.counts(obj)
+            counts = NaN(1, numel(obj.arenas));
+            for a = 1:numel(obj.arenas)
+                if Objects.isValid(obj.arenas{a})
+                    counts(a) = obj.arenas{a}.camera.frameCount;
+                end
+            end
+        end
+        
+        function period = get.period(obj)
+            period = obj.mPeriod;
+        end
+        
+        function set.period(obj, period)
+            if isnumeric(period) && isscalar(period) && period > 0
+                obj.mPeriod = period;
+                Objects.delete(obj.loopHandle);
+                obj.loopHandle = Scheduler.Repeat(@obj.loop, period);
+            else
+                error('Value provided for period is invalid.');
+            end
+        end
+        
+        function play = get.play(obj)
+            play = obj.mPlay;
+        end
+        
+        function set.play(obj, play)
+            obj.mPlay = play;
+            for a = 1:numel(obj.arenas)
+                if Objects.isValid(obj.arenas{a})
+                    obj.arenas{a}.play = play;
+                end
+            end
+        end
+    end
+    
+    methods (Access = private)
+        function loop(obj)
+            % Arenas.loop()
+            % Poll each camera once, starting with a different arena every
+            % time. Arenas closed by the user are skipped.
+            
+            nArenas = numel(obj.arenas);
+            for k = 0:nArenas - 1
+                a = mod(obj.first + k - 1, nArenas) + 1;
+                if Objects.isValid(obj.arenas{a})
+                    obj.arenas{a}.camera.step();
+                end
+            end
+            obj.first = mod(obj.first, nArenas) + 1;
+        end
+    end
+end
\ No newline at end of file
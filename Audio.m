@@ -0,0 +1,288 @@
+% Audio - Preloaded, non-blocking playback of tones and waveforms.
+% Sounds are rendered once (e.g. when zones are defined) and played later
+% with a single non-blocking call, so that the start of a sound does not
+% depend on the time it takes to synthesize it.
+%
+% Audio methods:
+%   calibrate - Measure the latency of the audio device with a loopback.
+%   load      - Pre-render a waveform and return its key.
+%   play      - Start playback of a preloaded sound without blocking.
+%   stop      - Stop all sounds.
+%   tone      - Pre-render a tone and return its key.
+%
+% Audio properties:
+%   deviceLatency - Latency (s) between the start of a player and the
+%                   sound leaving the device; NaN until calibrated.
+%   output        - Filename of the WAV file written by the 'wav' sink.
+%   sink          - Where sounds are played:
+%                     'speaker' - Default audio output device.
+%                     'wav'     - Mix all triggered sounds in a WAV file (headless).
+%                     'null'    - Only log triggers (headless).
+%   triggers      - Log of triggers with columns: trigger time, sound
+%                   index, dispatch latency and onset latency (s).
+%
+% The dispatch latency is the delay between a call to play and the
+% player's StartFcn. The onset latency adds deviceLatency, which is
+% measured by calibrate with a loopback from the output to the default
+% input (a cable, or a microphone next to the speaker) or set from an
+% external measure (e.g. an oscilloscope). Both are also recorded in
+% Metrics as 'audio_dispatch' and 'audio_onset'. Headless sinks have no
+% device and log NaN for both.
+%
+% Example:
+%   audio = Audio();
+%   audio.calibrate();
+%   key = audio.tone(1000, 0.5);
+%   audio.play(key);
+%   disp(audio.triggers);
+%
+% See also Tools.tone.
+
+% 2026-10-18. Leonardo Molina.
+% 2026-10-18. Last modified.
+classdef Audio < handle
+    properties (Dependent)
+        % triggers - Trigger time, sound index, dispatch and onset latency (s).
+        triggers
+    end
+    
+    properties
+        % deviceLatency - Latency (s) between the start of a player and the sound leaving the device.
+        deviceLatency = NaN
+        
+        % output - Filename of the WAV file written by the 'wav' sink.
+        output = 'Audio.wav'
+    end
+    
+    properties (SetAccess = private)
+        % fs - Sampling frequency of all sounds.
+        fs = 44100
+        
+        % sink - 'speaker', 'wav', or 'null'.
+        sink
+    end
+    
+    properties (Access = private)
+        keys = {}
+        players = {}
+        waveforms = {}
+        
+        metrics
+        mTriggers = zeros(0, 4)
+        pending = zeros(0, 2)
+        startTime
+    end
+    
+    methods
+        function obj = Audio(sink)
+            % Audio(<sink>)
+            % Create an audio engine with the given sink. The default sink is
+            % 'speaker' when an audio output device is available, otherwise
+            % 'null'.
+            
+            if nargin < 1
+                try
+                    available = audiodevinfo(0) > 0;
+                catch
+                    available = false;
+                end
+                if available
+                    sink = 'speaker';
+                else
+                    sink = 'null';
+                end
+            end
+            if ~ismember(sink, {'speaker', 'wav', 'null'})
+                error('Value provided for sink is invalid.');
+            end
+            obj.sink = sink;
+            obj.metrics = Metrics.Instance();
+            obj.startTime = tic;
+        end
+        
+        function delete(obj)
+            % Audio.delete()
+            % Stop all sounds and write the WAV file, if any.
+            
+            obj.stop();
+            if strcmp(obj.sink, 'wav')
+                obj.flush();
+            end
+        end
+        
+        function key = tone(obj, frequency, duration)
+            % key = Audio.tone(frequency, duration)
+            % Pre-render a tone with the given frequency (Hz) and duration
+            % (seconds). Repeated calls with the same parameters return the
+            % same key without rendering again.
+            
+            key = sprintf('tone:%g:%g', frequency, duration);
+            if ~ismember(key, obj.keys)
+                t = 0:1 / obj.fs:duration;
+                obj.load(key, sin(2 * pi * frequency * t), obj.fs);
+            end
+        end
+        
+        function key = load(obj, key, waveform, fs)
+            % key = Audio.load(key, waveform, fs)
+            % Pre-render a waveform sampled at fs (Hz) and associate it to
+            % the given key. Waveforms are resampled to Audio.fs.
+            
+            waveform = waveform(:);
+            if fs ~= obj.fs
+                n = numel(waveform);
+                waveform = interp1((0:n - 1) / fs, waveform, 0:1 / obj.fs:(n - 1) / fs, 'linear')';
+            end
+            k = find(ismember(obj.keys, key), 1);
+            if isempty(k)
+                k = numel(obj.keys) + 1;
+            else
+                Objects.delete(obj.players{k});
+            end
+            obj.keys{k} = key;
+            obj.waveforms{k} = waveform;
+            if strcmp(obj.sink, 'speaker')
+                obj.players{k} = audioplayer(waveform, obj.fs);
+                obj.players{k}.StartFcn = @(~, ~)obj.onStart(k);
+            else
+                obj.players{k} = [];
+            end
+        end
+        
+        function play(obj, key)
+            % Audio.play(key)
+            % Start playback of a preloaded sound without blocking. A sound
+            % already playing is restarted.
+            
+            k = find(ismember(obj.keys, key), 1);
+            if isempty(k)
+                error('Sound "%s" was not loaded.', key);
+            end
+            time = toc(obj.startTime);
+            switch obj.sink
+                case 'speaker'
+                    player = obj.players{k};
+                    obj.pending(end + 1, :) = [time, k];
+                    stop(player);
+                    play(player);
+                otherwise
+                    obj.mTriggers(end + 1, :) = [time, k, NaN, NaN];
+            end
+        end
+        
+        function latency = calibrate(obj, repeats)
+            % latency = Audio.calibrate(<repeats>)
+            % Measure deviceLatency with a loopback from the output to the
+            % default input device: a click is played while recording, and
+            % the delay until it is recorded is taken as the median of
+            % repeats (default 5) measures. The measure includes the input
+            % latency of the recording, so onset latencies are upper bounds.
+            
+            if nargin < 2
+                repeats = 5;
+            end
+            if ~strcmp(obj.sink, 'speaker')
+                error('Calibration requires the speaker sink.');
+            end
+            click = [ones(round(1e-3 * obj.fs), 1); zeros(round(0.5 * obj.fs), 1)];
+            player = audioplayer(click, obj.fs);
+            measures = NaN(1, repeats);
+            for r = 1:repeats
+                recorder = audiorecorder(obj.fs, 16, 1);
+                record(recorder);
+                while recorder.TotalSamples == 0
+                    pause(1e-3);
+                end
+                % Samples recorded before the click was sent.
+                offset = recorder.TotalSamples;
+                playblocking(player);
+                stop(recorder);
+                signal = abs(getaudiodata(recorder));
+                if max(signal) > 10 * median(signal)
+                    k = find(signal > 0.5 * max(signal), 1);
+                    measures(r) = max(0, k - 1 - offset) / obj.fs;
+                end
+            end
+            if all(isnan(measures))
+                error('The click was not captured by the input device.');
+            end
+            latency = median(measures(~isnan(measures)));
+            obj.deviceLatency = latency;
+        end
+        
+        function stop(obj)
+            % Audio.stop()
+            % Stop all sounds.
+            
+            for k = 1:numel(obj.players)
+                if ~isempty(obj.players{k})
+                    stop(obj.players{k});
+                end
+            end
+        end
+        
+        function set.deviceLatency(obj, deviceLatency)
+            if isnumeric(deviceLatency) && isscalar(deviceLatency) && (isnan(deviceLatency) || deviceLatency >= 0)
+                obj.deviceLatency = deviceLatency;
+            else
+                error('Value provided for deviceLatency is invalid.');
+            end
+        end
+        
+        function triggers = get.triggers(obj)
+            triggers = obj.mTriggers;
+        end
+    end
+    
+    methods (Access = private)
+        function flush(obj)
+            % Audio.flush()
+            % Write all triggered sounds to the output WAV file, mixed at
+            % the time they were triggered.
+            
+            if ~isempty(obj.mTriggers)
+                starts = round(obj.mTriggers(:, 1) * obj.fs);
+                ends = starts + cellfun(@numel, obj.waveforms(obj.mTriggers(:, 2)))';
+                track = zeros(max(ends), 1);
+                for o = 1:size(obj.mTriggers, 1)
+                    k = obj.mTriggers(o, 2);
+                    track(starts(o) + 1:ends(o)) = track(starts(o) + 1:ends(o)) + obj.waveforms{k};
+                end
+                audiowrite(obj.output, track / max(1, max(abs(track))), obj.fs);
+            end
+        end
+        
+        function onStart(obj, k)
+            % Audio.onStart(k)
+            % Playback was dispatched; log dispatch and onset latency of the
+            % oldest trigger for this sound.
+            
+            p = find(obj.pending(:, 2) == k, 1);
+            if ~isempty(p)
+                time = obj.pending(p, 1);
+                obj.pending(p, :) = [];
+                dispatch = toc(obj.startTime) - time;
+                onset = dispatch + obj.deviceLatency;
+                obj.mTriggers(end + 1, :) = [time, k, dispatch, onset];
+                obj.metrics.observe('audio_dispatch', dispatch);
+                if ~isnan(onset)
+                    obj.metrics.observe('audio_onset', onset);
+                end
+            end
+        end
+    end
+    
+    methods (Static)
+        function instance = Instance()
+            % instance = Audio.Instance()
+            % Shared audio engine.
+            
+            if Global.contains('Audio')
+                instance = Global.get('Audio');
+            else
+                instance = Audio();
+                Global.set('Audio', instance);
+            end
+        end
+    end
+end
\ No newline at end of file
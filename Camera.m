@@ -4,21 +4,30 @@
 %   Resolution      - The resolution changed.
 % 
 % Camera methods:
+%   Names           - Return the names of recognized video resources.
 %   count           - Return the number of recognized video resources.
 %   delete          - Release video resource and delete this object.
 %   getFrame        - Return current frame.
+%   step            - Capture a frame when driven by an external clock.
 %
 % Camera properties:
 %   frame           - Last captured frame.
+%   frameCount      - Number of frames captured.
+%   frameTime       - Time (tic) at which the last frame was captured.
 %   mirror          - Mirror horizontal and vertical axes.
 %   play            - Play/pause acquiring frames.
 %   resolutionIndex - Set/get the video resolution.
 %   resolutionList  - List available resolutions.
 %   exposure        - Set/get exposure.
 %   exposureRange   - Get exposure range.
+%   external        - Frames are pulled with step rather than by the camera's own loop.
+%
+% The backend, resolution list and exposure range of each device are cached
+% (see Camera.capabilitiesFile) after they are probed for the first time, so
+% that later sessions open the right backend directly without probing.
 
 % 2016-11-30. Leonardo Molina.
-% 2018-07-09. Last modified.
+% 2026-10-18. Last modified.
 classdef Camera < Event % pretend-CameraInterface
     properties (Dependent)
         % exposure - Set/get the camera exposure. If not available, exposure = Inf.
@@ -46,6 +55,20 @@ classdef Camera < Event % pretend-CameraInterface
         resolutionList
     end
     
+    properties
+        % external - While playing, frames are pulled by an external clock
+        % calling step (true), rather than by the camera's own loop (false).
+        external = false
+    end
+    
+    properties (SetAccess = private)
+        % frameCount - Number of frames captured; identifies frames across the pipeline.
+        frameCount = 0
+        
+        % frameTime - Time (tic) at which the last frame was captured.
+        frameTime
+    end
+    
     properties (Access = private)
         % Internal camera object.
         camera
@@ -57,25 +80,64 @@ classdef Camera < Event % pretend-CameraInterface
         playHandle
         
         scheduler
+        trace
+        
+        % Frames dropped are estimated from gaps in the frame period.
+        metrics
+        period = NaN
     end
     
     methods
         function obj = Camera(varargin)
+            % Camera(<cameraId>)
             % Wrap either a webcam or videoinput class, whichever is able
             % to access a video resource.
+            % 
+            % Camera(backend)
+            % Wrap a camera backend object such as Camera.Synthetic.
             
             % Camera factory. Support for a specific resource cannot be
             % determined before hand in MATLAB, hence try opening it with
-            % one of two controllers then check for errors.
+            % one of two controllers then check for errors. Devices opened
+            % before are opened directly with their cached capabilities.
             errors = [];
-            try
-                obj.camera = Camera.Webcams(varargin{:});
-            catch e1
-                errors = [errors, e1];
-                try
-                    obj.camera = Camera.VideoInputs(varargin{:});
-                catch e2
-                    errors = [errors, e2];
+            if nargin > 0 && isobject(varargin{1})
+                obj.camera = varargin{1};
+            else
+                if nargin == 0
+                    id = 1;
+                else
+                    id = varargin{1};
+                end
+                names = Camera.Names();
+                if id >= 1 && id <= numel(names)
+                    name = names{id};
+                else
+                    name = '';
+                end
+                cache = Camera.loadCapabilities();
+                k = find(strcmp({cache.name}, name), 1);
+                if ~isempty(k)
+                    try
+                        obj.camera = feval(cache(k).backend, id, cache(k));
+                    catch
+                        % Device changed since it was cached; probe again.
+                    end
+                end
+                if isempty(obj.camera)
+                    try
+                        obj.camera = Camera.Webcams(id);
+                    catch e1
+                        errors = [errors, e1];
+                        try
+                            obj.camera = Camera.VideoInputs(id);
+                        catch e2
+                            errors = [errors, e2];
+                        end
+                    end
+                    if isempty(errors) && ~isempty(name)
+                        Camera.saveCapabilities(name, class(obj.camera), obj.camera.capabilities());
+                    end
                 end
             end
             success = isempty(errors);
@@ -91,6 +153,8 @@ classdef Camera < Event % pretend-CameraInterface
             end
             
             obj.scheduler = Scheduler();
+            obj.trace = Trace.Instance();
+            obj.metrics = Metrics.Instance();
         end
         
         function delete(obj)
@@ -114,7 +178,12 @@ classdef Camera < Event % pretend-CameraInterface
         
         function set.play(obj, play)
             if play && ~obj.play
-                obj.playHandle = obj.scheduler.repeat(@obj.loop, 2e-3);
+                % Frame period is estimated anew in every run.
+                obj.frameTime = [];
+                obj.period = NaN;
+                if ~obj.external
+                    obj.playHandle = obj.scheduler.repeat(@obj.loop, 2e-3);
+                end
                 obj.mPlay = true;
             elseif obj.play && ~play
                 Objects.delete(obj.playHandle);
@@ -138,10 +207,26 @@ classdef Camera < Event % pretend-CameraInterface
             obj.mFrame = obj.camera.getFrame(varargin{:});
             frame = obj.frame;
             if available
+                obj.onCapture();
                 obj.invoke('Frame', frame);
             end
         end
         
+        function captured = step(obj)
+            % captured = Camera.step()
+            % Capture and report a new frame, if playing and available.
+            % Return whether a frame was captured.
+            
+            captured = obj.play && obj.camera.hasFrame;
+            if captured
+                span = obj.trace.start('Camera.loop', obj.frameCount + 1);
+                obj.mFrame = obj.camera.getFrame();
+                obj.onCapture();
+                obj.invoke('Frame', obj.frame);
+                obj.trace.stop(span);
+            end
+        end
+        
         function set.mirror(obj, mirror)
             if numel(mirror) == 2 && islogical(mirror)
                 obj.mMirror = mirror;
@@ -197,10 +282,27 @@ classdef Camera < Event % pretend-CameraInterface
     
     methods (Access = private)
         function loop(obj)
-            if obj.play && obj.camera.hasFrame
-                obj.mFrame = obj.camera.getFrame();
-                obj.invoke('Frame', obj.frame);
+            obj.step();
+        end
+        
+        function onCapture(obj)
+            % Camera.onCapture()
+            % Count a new frame and estimate frames dropped since the last
+            % one from the running frame period, within the same run.
+            
+            if obj.play && ~isempty(obj.frameTime)
+                interval = toc(obj.frameTime);
+                if isnan(obj.period)
+                    obj.period = interval;
+                elseif interval < 1.5 * obj.period
+                    obj.period = 0.9 * obj.period + 0.1 * interval;
+                else
+                    obj.metrics.count('frames_dropped', round(interval / obj.period) - 1);
+                end
             end
+            obj.frameTime = tic;
+            obj.frameCount = obj.frameCount + 1;
+            obj.metrics.count('frames');
         end
     end
     
@@ -209,8 +311,58 @@ classdef Camera < Event % pretend-CameraInterface
             % Camera.count()
             % Return the number of recognized video resources.
             
-            list = webcamlist();
-            n = numel(list);
+            n = numel(Camera.Names());
+        end
+        
+        function names = Names(refresh)
+            % names = Camera.Names(<refresh>)
+            % Return the names of recognized video resources. The list is
+            % enumerated once per session, unless refresh is true.
+            
+            if (nargin == 1 && refresh) || ~Global.contains('CameraNames')
+                Global.set('CameraNames', webcamlist());
+            end
+            names = Global.get('CameraNames');
+        end
+        
+        function filename = capabilitiesFile()
+            % filename = Camera.capabilitiesFile()
+            % File with cached capabilities; delete it to force probing.
+            
+            filename = fullfile(prefdir, 'Camera.capabilities.mat');
+        end
+    end
+    
+    methods (Static, Access = private)
+        function cache = loadCapabilities()
+            % cache = Camera.loadCapabilities()
+            % Load cached capabilities of all devices opened before.
+            
+            filename = Camera.capabilitiesFile();
+            if exist(filename, 'file') == 2
+                c = load(filename);
+                cache = c.cache;
+            else
+                cache = struct('name', {}, 'backend', {});
+            end
+        end
+        
+        function saveCapabilities(name, backend, capabilities)
+            % Camera.saveCapabilities(name, backend, capabilities)
+            % Cache the backend and capabilities of the given device.
+            
+            cache = Camera.loadCapabilities();
+            k = find(strcmp({cache.name}, name), 1);
+            if isempty(k)
+                k = numel(cache) + 1;
+            end
+            capabilities.name = name;
+            capabilities.backend = backend;
+            fields = fieldnames(capabilities);
+            for f = 1:numel(fields)
+                cache(k).(fields{f}) = capabilities.(fields{f});
+            end
+            save(Camera.capabilitiesFile(), 'cache');
         end
     end
 end
\ No newline at end of file
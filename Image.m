@@ -34,7 +34,7 @@
 % Also see UI, Event.
 
 % 2018-05-30. Leonardo Molina.
-% 2018-07-16. Last modified.
+% 2026-10-18. Last modified.
 classdef Image < Event
     properties (Dependent)
         % image - Set/get image in the figure.
@@ -54,6 +54,9 @@ classdef Image < Event
         % imageHandle - Image handle for rendering images.
         imageHandle
         
+        % imageSize - Size of the last image, to skip redundant axis updates.
+        imageSize = [0, 0]
+        
         % ui - Reference to the UI object forwarding mouse events.
         ui
     end
@@ -101,13 +104,17 @@ classdef Image < Event
         function set.image(obj, image)
             dim = size(image);
             obj.imageHandle.CData = image;
-            k = 0.5;
-            if dim(1) < dim(2)
-                d = k * dim(2) / dim(1);
-                set(obj.imageHandle, 'XData', [-d, +d], 'YData', [-k, +k]);
-            else
-                d = k * dim(1) / dim(2);
-                set(obj.imageHandle, 'XData', [-k, +k], 'YData', [-d, +d]);
+            % Axis limits only change with the image size.
+            if ~isequal(dim(1:2), obj.imageSize)
+                obj.imageSize = dim(1:2);
+                k = 0.5;
+                if dim(1) < dim(2)
+                    d = k * dim(2) / dim(1);
+                    set(obj.imageHandle, 'XData', [-d, +d], 'YData', [-k, +k]);
+                else
+                    d = k * dim(1) / dim(2);
+                    set(obj.imageHandle, 'XData', [-k, +k], 'YData', [-d, +d]);
+                end
             end
         end
         
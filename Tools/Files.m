@@ -7,5 +7,18 @@ classdef Files
             end
             fid = fopen(path, varargin{:});
         end
+        
+        function path = unique(path)
+            % path = Files.unique(path)
+            % Append a numeric suffix to the filename if it already exists,
+            % e.g. when several sessions start within the same second.
+            
+            [folder, name, extension] = fileparts(path);
+            k = 1;
+            while exist(path, 'file') == 2
+                k = k + 1;
+                path = fullfile(folder, sprintf('%s-%i%s', name, k, extension));
+            end
+        end
     end
 end
\ No newline at end of file
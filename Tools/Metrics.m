@@ -0,0 +1,276 @@
+% Metrics - Registry of latency histograms, counters and gauges.
+% Histograms are log-linear (8 buckets per power of two, from 1us to about
+% 18 minutes), so recording a value is a constant-time bucket increment and
+% quantiles are exact to within 12.5%. Recording is cheap enough to be left
+% on permanently.
+%
+% Metrics are exposed in the Prometheus text exposition format, either as
+% periodic snapshots to a file (e.g. for node_exporter's textfile
+% collector) or from a plain HTTP endpoint bound to localhost.
+%
+% Metrics methods:
+%   count    - Increment a counter.
+%   gauge    - Set a gauge.
+%   observe  - Record a latency (s) in a histogram.
+%   serve    - Serve metrics on http://127.0.0.1:<port>/metrics
+%   snapshot - Periodically write metrics to a file.
+%   text     - Return metrics in Prometheus text exposition format.
+%
+% Example:
+%   metrics = Metrics.Instance();
+%   metrics.snapshot('metrics.prom', 5);
+%   metrics.serve(9100);
+%   for i = 1:100
+%       t = tic;
+%       pause(0.01);
+%       metrics.observe('work', toc(t));
+%       metrics.count('iterations');
+%   end
+%   disp(metrics.text());
+
+% 2026-10-18. Leonardo Molina.
+% 2026-10-18. Last modified.
+classdef Metrics < handle
+    properties (Constant)
+        % prefix - Prefix of all metric names.
+        prefix = 'virtualtracker'
+        
+        % quantiles - Quantiles reported for each histogram.
+        quantiles = [0.5, 0.9, 0.99, 0.999]
+    end
+    
+    properties (Constant, Access = private)
+        % Log-linear buckets: resolution per power of two, number of powers of two.
+        nSubBuckets = 8
+        nOctaves = 30
+    end
+    
+    properties (Access = private)
+        % Histograms: name to index, bucket counts, sum of values.
+        histogramMap
+        histogramNames = cell(1, 0)
+        histogramCounts = zeros(0, 0)
+        histogramSums = zeros(1, 0)
+        
+        % Counters and gauges: name to index, values.
+        counterMap
+        counterNames = cell(1, 0)
+        counterValues = zeros(1, 0)
+        gaugeMap
+        gaugeNames = cell(1, 0)
+        gaugeValues = zeros(1, 0)
+        
+        % Exports.
+        output
+        server
+        serverHandle
+        snapshotHandle
+    end
+    
+    methods
+        function obj = Metrics()
+            % Metrics()
+            % Create an empty registry.
+            
+            obj.histogramMap = containers.Map('KeyType', 'char', 'ValueType', 'double');
+            obj.counterMap = containers.Map('KeyType', 'char', 'ValueType', 'double');
+            obj.gaugeMap = containers.Map('KeyType', 'char', 'ValueType', 'double');
+            obj.histogramCounts = zeros(Metrics.nSubBuckets * Metrics.nOctaves, 0);
+        end
+        
+        function delete(obj)
+            % Metrics.delete()
+            % Stop exports and release the endpoint.
+            
+            Objects.delete(obj.snapshotHandle, obj.serverHandle);
+            if ~isempty(obj.server)
+                obj.server.close();
+            end
+        end
+        
+        function observe(obj, name, value)
+            % Metrics.observe(name, value)
+            % Record a latency value (seconds) in the histogram with the given name.
+            
+            if isKey(obj.histogramMap, name)
+                h = obj.histogramMap(name);
+            else
+                h = numel(obj.histogramNames) + 1;
+                obj.histogramMap(name) = h;
+                obj.histogramNames{h} = name;
+                obj.histogramCounts(:, h) = 0;
+                obj.histogramSums(h) = 0;
+            end
+            b = Metrics.bucket(value);
+            obj.histogramCounts(b, h) = obj.histogramCounts(b, h) + 1;
+            obj.histogramSums(h) = obj.histogramSums(h) + value;
+        end
+        
+        function count(obj, name, amount)
+            % Metrics.count(name, <amount>)
+            % Increment the counter with the given name by amount (default 1).
+            
+            if nargin < 3
+                amount = 1;
+            end
+            if isKey(obj.counterMap, name)
+                c = obj.counterMap(name);
+            else
+                c = numel(obj.counterNames) + 1;
+                obj.counterMap(name) = c;
+                obj.counterNames{c} = name;
+                obj.counterValues(c) = 0;
+            end
+            obj.counterValues(c) = obj.counterValues(c) + amount;
+        end
+        
+        function gauge(obj, name, value)
+            % Metrics.gauge(name, value)
+            % Set the gauge with the given name.
+            
+            if isKey(obj.gaugeMap, name)
+                g = obj.gaugeMap(name);
+            else
+                g = numel(obj.gaugeNames) + 1;
+                obj.gaugeMap(name) = g;
+                obj.gaugeNames{g} = name;
+            end
+            obj.gaugeValues(g) = value;
+        end
+        
+        function str = text(obj)
+            % str = Metrics.text()
+            % Return all metrics in Prometheus text exposition format.
+            
+            lines = cell(1, 0);
+            name = sprintf('%s_latency_seconds', Metrics.prefix);
+            if ~isempty(obj.histogramNames)
+                lines{end + 1} = sprintf('# TYPE %s summary', name);
+            end
+            for h = 1:numel(obj.histogramNames)
+                counts = obj.histogramCounts(:, h);
+                total = sum(counts);
+                cumulative = cumsum(counts);
+                for q = Metrics.quantiles
+                    b = find(cumulative >= q * total, 1);
+                    lines{end + 1} = sprintf('%s{stage="%s",quantile="%g"} %.9g', name, obj.histogramNames{h}, q, Metrics.upper(b)); %#ok<AGROW>
+                end
+                lines{end + 1} = sprintf('%s_sum{stage="%s"} %.9g', name, obj.histogramNames{h}, obj.histogramSums(h)); %#ok<AGROW>
+                lines{end + 1} = sprintf('%s_count{stage="%s"} %i', name, obj.histogramNames{h}, total); %#ok<AGROW>
+            end
+            for c = 1:numel(obj.counterNames)
+                name = sprintf('%s_%s_total', Metrics.prefix, obj.counterNames{c});
+                lines{end + 1} = sprintf('# TYPE %s counter', name); %#ok<AGROW>
+                lines{end + 1} = sprintf('%s %.9g', name, obj.counterValues(c)); %#ok<AGROW>
+            end
+            for g = 1:numel(obj.gaugeNames)
+                name = sprintf('%s_%s', Metrics.prefix, obj.gaugeNames{g});
+                lines{end + 1} = sprintf('# TYPE %s gauge', name); %#ok<AGROW>
+                lines{end + 1} = sprintf('%s %.9g', name, obj.gaugeValues(g)); %#ok<AGROW>
+            end
+            str = sprintf('%s\n', lines{:});
+        end
+        
+        function snapshot(obj, filename, period)
+            % Metrics.snapshot(filename, period)
+            % Write metrics to the given file every period seconds. Files
+            % are replaced atomically so that readers never see partial data.
+            
+            Objects.delete(obj.snapshotHandle);
+            obj.output = filename;
+            obj.snapshotHandle = Scheduler.Repeat(@obj.onSnapshot, period);
+        end
+        
+        function serve(obj, port)
+            % Metrics.serve(port)
+            % Serve metrics over HTTP on the loopback interface. Connections
+            % are accepted without blocking from a scheduler loop.
+            
+            Objects.delete(obj.serverHandle);
+            if ~isempty(obj.server)
+                obj.server.close();
+            end
+            obj.server = java.net.ServerSocket(port, 8, java.net.InetAddress.getByName('127.0.0.1'));
+            obj.server.setSoTimeout(1);
+            obj.serverHandle = Scheduler.Repeat(@obj.onServe, 0.1);
+        end
+    end
+    
+    methods (Access = private)
+        function onSnapshot(obj)
+            % Metrics.onSnapshot()
+            % Write metrics to a temporary file, then replace the output.
+            
+            temporary = sprintf('%s.tmp', obj.output);
+            fid = fopen(temporary, 'w');
+            fprintf(fid, '%s', obj.text());
+            fclose(fid);
+            movefile(temporary, obj.output, 'f');
+        end
+        
+        function onServe(obj)
+            % Metrics.onServe()
+            % Answer pending HTTP requests with the current metrics.
+            
+            try
+                client = obj.server.accept();
+            catch
+                % No pending connections.
+                client = [];
+            end
+            if ~isempty(client)
+                try
+                    client.setSoTimeout(100);
+                    reader = java.io.BufferedReader(java.io.InputStreamReader(client.getInputStream()));
+                    reader.readLine();
+                    body = obj.text();
+                    header = sprintf('HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: %i\r\n\r\n', numel(body));
+                    stream = client.getOutputStream();
+                    stream.write(typecast(uint8([header, body]), 'int8'));
+                    stream.flush();
+                catch
+                end
+                client.close();
+            end
+        end
+    end
+    
+    methods (Static)
+        function instance = Instance()
+            % instance = Metrics.Instance()
+            % Shared registry used across the pipeline.
+            
+            if Global.contains('Metrics')
+                instance = Global.get('Metrics');
+            else
+                instance = Metrics();
+                Global.set('Metrics', instance);
+            end
+        end
+    end
+    
+    methods (Static, Access = private)
+        function b = bucket(value)
+            % b = Metrics.bucket(value)
+            % Index of the log-linear bucket for a value in seconds.
+            
+            us = max(1, value * 1e6);
+            octave = floor(log2(us));
+            sub = floor((us / 2 ^ octave - 1) * Metrics.nSubBuckets);
+            b = min(octave * Metrics.nSubBuckets + sub + 1, Metrics.nSubBuckets * Metrics.nOctaves);
+        end
+        
+        function value = upper(b)
+            % value = Metrics.upper(b)
+            % Upper bound (seconds) of a bucket.
+            
+            if isempty(b)
+                value = NaN;
+            else
+                octave = floor((b - 1) / Metrics.nSubBuckets);
+                sub = mod(b - 1, Metrics.nSubBuckets);
+                value = 2 ^ octave * (1 + (sub + 1) / Metrics.nSubBuckets) * 1e-6;
+            end
+        end
+    end
+end
\ No newline at end of file
@@ -0,0 +1,110 @@
+% Ring - Fixed-capacity ring buffer of column vectors.
+% Appending is O(1): once the capacity is reached, the oldest column is
+% overwritten in place. Each column is written twice, capacity columns
+% apart, so that the columns held are always contiguous in storage and
+% are read in chronological order with a single range.
+%
+% Ring methods:
+%   clear - Remove all elements.
+%   push  - Append a column, overwriting the oldest when full.
+%
+% Ring properties:
+%   capacity - Maximum number of columns kept.
+%   count    - Number of columns currently held.
+%   data     - Columns in chronological order (copy).
+%   last     - Most recent column.
+%
+% Example:
+%   trail = Ring(3, 2);
+%   trail.push([1; 1]);
+%   trail.push([2; 2]);
+%   trail.push([3; 3]);
+%   trail.push([4; 4]);
+%   trail.data %==> [2 3 4; 2 3 4]
+%   h = plot(trail.data(1, :), trail.data(2, :));
+
+% 2026-10-18. Leonardo Molina.
+% 2026-10-18. Last modified.
+classdef Ring < handle
+    properties (Dependent)
+        % capacity - Maximum number of columns kept.
+        capacity
+        
+        % count - Number of columns currently held.
+        count
+        
+        % data - Columns in chronological order.
+        data
+        
+        % last - Most recent column.
+        last
+    end
+    
+    properties (Access = private)
+        % buffer - Storage, twice the capacity.
+        buffer
+        
+        % head - Column index of the most recent element.
+        head = 0
+        
+        % mCount - Number of columns currently held.
+        mCount = 0
+    end
+    
+    methods
+        function obj = Ring(capacity, rows)
+            % Ring(capacity, <rows>)
+            % Create a ring buffer holding up to capacity columns with the
+            % given number of rows (default 1).
+            
+            if nargin < 2
+                rows = 1;
+            end
+            if ~isnumeric(capacity) || ~isscalar(capacity) || capacity < 1 || capacity ~= round(capacity) || ~isfinite(capacity)
+                error('Value provided for capacity is invalid.');
+            end
+            obj.buffer = NaN(rows, 2 * capacity);
+        end
+        
+        function push(obj, value)
+            % Ring.push(value)
+            % Append a column, overwriting the oldest one when full.
+            
+            n = obj.capacity;
+            obj.head = mod(obj.head, n) + 1;
+            obj.buffer(:, [obj.head, obj.head + n]) = [value(:), value(:)];
+            obj.mCount = min(obj.mCount + 1, n);
+        end
+        
+        function clear(obj)
+            % Ring.clear()
+            % Remove all elements.
+            
+            obj.buffer(:) = NaN;
+            obj.head = 0;
+            obj.mCount = 0;
+        end
+        
+        function capacity = get.capacity(obj)
+            capacity = size(obj.buffer, 2) / 2;
+        end
+        
+        function count = get.count(obj)
+            count = obj.mCount;
+        end
+        
+        function data = get.data(obj)
+            % Columns head - count + 1 to head, shifted by capacity to stay in range.
+            last = obj.head + obj.capacity;
+            data = obj.buffer(:, last - obj.mCount + 1:last);
+        end
+        
+        function last = get.last(obj)
+            if obj.mCount == 0
+                last = zeros(size(obj.buffer, 1), 0);
+            else
+                last = obj.buffer(:, obj.head);
+            end
+        end
+    end
+end
\ No newline at end of file
@@ -9,7 +9,7 @@
 %   tone              - Play a tone with the given frequency and duration.
 
 % 2016-05-12. Leonardo Molina.
-% 2018-07-09. Last modified.
+% 2026-10-18. Last modified.
 classdef Tools
     methods (Static)
         function c = argsToCell(varargin)
@@ -297,11 +297,13 @@ classdef Tools
         function tone(frequency, duration)
             % Tools.tone(frequency, duration)
             % Play a tone with the given frequency (Hz) and duration (seconds) in the computer speaker.
+            % The tone is rendered on first use and reused afterwards; render
+            % it ahead of time with Audio.Instance().tone(frequency, duration).
+            % 
+            % See also Audio.
             
-            fs = min(44100, max(1000, 9 * frequency));
-            t = 0:1 / fs:duration;
-            y = sin(2 * pi * frequency * t);
-            sound(y, fs);
+            audio = Audio.Instance();
+            audio.play(audio.tone(frequency, duration));
         end
     end
 end
\ No newline at end of file
@@ -0,0 +1,173 @@
+% Trace - Low-overhead scoped tracing of the acquisition pipeline.
+% Spans are recorded in a preallocated ring buffer (the newest events
+% overwrite the oldest) and saved as Chrome trace JSON, which can be opened
+% with chrome://tracing or https://ui.perfetto.dev
+% Spans tagged with the same frame number are linked with flow arrows, so
+% that the path of one frame across the pipeline can be followed.
+%
+% Tracing is disabled by default; while disabled, start and stop return
+% immediately.
+%
+% Trace methods:
+%   clear - Discard all recorded events.
+%   save  - Save recorded events as Chrome trace JSON.
+%   start - Open a span.
+%   stop  - Close a span.
+%
+% Trace properties:
+%   capacity - Maximum number of events kept.
+%   enabled  - Record events (true) or not (false).
+%
+% Example:
+%   trace = Trace.Instance();
+%   trace.enabled = true;
+%   for frame = 1:10
+%       span = trace.start('work', frame);
+%       pause(0.01);
+%       trace.stop(span);
+%   end
+%   trace.save('trace.json');
+
+% 2026-10-18. Leonardo Molina.
+% 2026-10-18. Last modified.
+classdef Trace < handle
+    properties
+        % enabled - Record events (true) or not (false).
+        enabled = false
+    end
+    
+    properties (Dependent)
+        % capacity - Maximum number of events kept.
+        capacity
+    end
+    
+    properties (Access = private)
+        % Event data: name, start time (us), duration (us), and frame number.
+        names = cell(1, 0)
+        starts = zeros(1, 0)
+        durations = zeros(1, 0)
+        frames = zeros(1, 0)
+        
+        % count - Number of events recorded since the last clear.
+        count = 0
+        
+        % startTime - Reference for all timestamps (monotonic).
+        startTime
+    end
+    
+    methods
+        function obj = Trace(capacity)
+            % Trace(<capacity>)
+            % Create a trace buffer holding up to capacity events (default 1e5).
+            
+            if nargin < 1
+                capacity = 1e5;
+            end
+            obj.capacity = capacity;
+        end
+        
+        function k = start(obj, name, frame)
+            % span = Trace.start(name, <frame>)
+            % Open a span with the given name, optionally tagged with a frame
+            % number. Return a handle to pass to Trace.stop.
+            
+            if obj.enabled
+                obj.count = obj.count + 1;
+                k = mod(obj.count - 1, numel(obj.starts)) + 1;
+                obj.names{k} = name;
+                obj.starts(k) = 1e6 * toc(obj.startTime);
+                obj.durations(k) = 0;
+                if nargin < 3
+                    obj.frames(k) = 0;
+                else
+                    obj.frames(k) = frame;
+                end
+            else
+                k = 0;
+            end
+        end
+        
+        function stop(obj, k)
+            % Trace.stop(span)
+            % Close a span returned by Trace.start.
+            
+            if k > 0
+                obj.durations(k) = 1e6 * toc(obj.startTime) - obj.starts(k);
+            end
+        end
+        
+        function clear(obj)
+            % Trace.clear()
+            % Discard all recorded events and restart the clock.
+            
+            obj.count = 0;
+            obj.startTime = tic;
+        end
+        
+        function save(obj, filename)
+            % Trace.save(filename)
+            % Save recorded events in Chrome trace JSON format. Spans share
+            % a flow id with other spans of the same frame.
+            
+            n = min(obj.count, obj.capacity);
+            order = mod(obj.count - n:obj.count - 1, obj.capacity) + 1;
+            names = obj.names(order);
+            starts = obj.starts(order);
+            durations = obj.durations(order);
+            frames = obj.frames(order);
+            
+            spans = cell(1, n);
+            for e = 1:n
+                spans{e} = struct('name', names{e}, 'cat', 'pipeline', 'ph', 'X', 'ts', starts(e), 'dur', durations(e), 'pid', 1, 'tid', 1, 'args', struct('frame', frames(e)));
+            end
+            % Link spans of the same frame: start, steps, and finish. A stable
+            % sort groups spans by frame and keeps each group in time order.
+            tagged = find(frames > 0);
+            [sorted, o] = sort(frames(tagged));
+            k = tagged(o);
+            first = [true, diff(sorted) ~= 0];
+            last = [diff(sorted) ~= 0, true];
+            linked = ~(first & last);
+            k = k(linked);
+            phases = repmat({'t'}, 1, numel(k));
+            phases(first(linked)) = {'s'};
+            phases(last(linked)) = {'f'};
+            flows = cell(1, numel(k));
+            for i = 1:numel(k)
+                flows{i} = struct('name', 'frame', 'cat', 'flow', 'ph', phases{i}, 'id', frames(k(i)), 'ts', starts(k(i)), 'pid', 1, 'tid', 1, 'bp', 'e');
+            end
+            events = [spans, flows];
+            
+            fid = fopen(filename, 'w');
+            fprintf(fid, '{"traceEvents":[%s],"displayTimeUnit":"ms"}', strjoin(cellfun(@jsonencode, events, 'UniformOutput', false), ','));
+            fclose(fid);
+        end
+        
+        function capacity = get.capacity(obj)
+            capacity = numel(obj.starts);
+        end
+        
+        function set.capacity(obj, capacity)
+            capacity = round(capacity);
+            obj.names = cell(1, capacity);
+            obj.starts = zeros(1, capacity);
+            obj.durations = zeros(1, capacity);
+            obj.frames = zeros(1, capacity);
+            obj.clear();
+        end
+    end
+    
+    methods (Static)
+        function instance = Instance()
+            % instance = Trace.Instance()
+            % Shared trace buffer used across the pipeline.
+            
+            if Global.contains('Trace')
+                instance = Global.get('Trace');
+            else
+                instance = Trace();
+                Global.set('Trace', instance);
+            end
+        end
+    end
+end
\ No newline at end of file
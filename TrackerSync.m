@@ -4,11 +4,12 @@
 % device.
 % 
 % Digital inputs from an Arduino will trigger an entry to a comma-separated
-% log file with: time, x, y, pin, count
+% log file with: time, x, y, pin, count, device
 % Which means that, at a given time, the position of the target was x and y,
 % and the pin had toggled low/high as the count indicates. Even numbers
 % correspond to low states, odd numbers to high states. If the first state 
-% is low, the count starts at 0, otherwise at 1.
+% is low, the count starts at 0, otherwise at 1. device is the time (s)
+% of the toggle in the clock of the device, if reported, or else NaN.
 % Data is saved to disk with every trigger, hence a decline in performance
 % is expected with higher trigger frequencies.
 % The location of the log file is Documents/TrackerSync/<timestamp>.csv
@@ -17,25 +18,141 @@
 %   bits 1 to 6 indicate the pin number.
 %   bit 7 indicates a positive or a negative change with 0 or 1, respectively.
 %   bit 8 must be set to zero.
-% An extended protocol (not provided here) is enabled when bit 8 is set to
-% one. A minimalistic firmware -compliant with such protocol- is included
+% An extended packet starts with a byte with bit 8 set to one, where bits 1
+% to 7 indicate the packet type; it follows with the length of the payload
+% and the payload. Packets of unknown types are skipped. Packet types:
+%   1: glitches rejected by the device; pin (uint8), count (uint32).
+%   2: loop timing and interrupt load of the device; see monitor.
+%   3: block of analog samples; see the Analog event.
+%   4: pulse measurements of a pin; see pulses.
+%   5: sync pulse emitted or received by the device; see syncPulses.
+%   6: pin toggle (same as a single byte) followed by its time (uint32, us).
+%   7: zone entry or exit on the device; see the Zone event.
+%   8: overruns and misses of each task of the device; see monitor.
+%   9: hello, in reply to a hello from the host; see transport.
+% Commands sent to the device are extended packets of the same form.
+% A minimalistic firmware -compliant with such protocol- is included
 % and can be installed using the Arduino IDE. Such program enables pins 16
 % to 19 as digital inputs by default.
 % 
+% TrackerSync methods:
+%   ingest        - Process serial data as if received from the device.
+%   requestPulses - Request pulse measurements from the device.
+%   setZone       - Set a zone on the device, which drives an output.
+% 
+% TrackerSync properties:
+%   glitches - Count of glitches rejected by the device, per pin.
+%   monitor  - Latest loop timing and interrupt load reported by the device.
+%   pulses   - Latest pulse measurements reported by the device, per pin.
+%   syncPulses - Sync pulses emitted or received by the device.
+%   transport  - Link to the device, as described by the firmware.
+% 
+% The baud rate is found with a handshake: a hello is sent at each of
+% TrackerSync.baudrates in turn until the firmware answers with a
+% description of the link, in transport:
+%   Version      - Protocol version.
+%   NativeUSB    - Whether the device is a native USB port (the baud rate
+%                  is then irrelevant).
+%   Instrumented - Whether the firmware was built with BRIDGE_INSTRUMENT.
+%   Baudrate     - Baud rate of the firmware.
+%   PacketSize   - Size (bytes) of the batches sent by the device.
+% Firmware that does not answer is assumed to use the last baud rate tried.
+% 
+% Firmware built with BRIDGE_INSTRUMENT reports every second, in monitor:
+%   LoopHistogram - Count of loop periods in bins [2^(b + 1), 2^(b + 2)) us.
+%   LoopMax       - Maximum loop period (us).
+%   StepMax       - Maximum duration of a step (us).
+%   InterruptRate - Interrupts per second.
+%   TxHighWater   - High-water mark of the transmission buffer (bytes).
+%   CatchUp       - Maximum number of toggles replayed in a single step.
+%   Overruns      - Steps of each task that exceeded their budget.
+%   Misses        - Steps of each task that started after their deadline.
+% A device near saturation shows long loop periods, a full transmission
+% buffer or a catch-up depth above 1, before frame triggers are lost.
+% 
+% TrackerSync events:
+%   Analog(data)  - Analog samples were received.
+%   Pulses(data)  - Pulse measurements of a pin were received.
+%   Serial(bytes) - Bytes were received from the serial device.
+%   Zone(data)    - A zone on the device was entered or exited.
+% 
+% Analog samples are decoded into a struct with fields Time (s, device
+% clock, at the start of each scan of all channels), Channels (ADC channel
+% numbers) and Values (one row per scan, one column per channel), and
+% logged to Documents/TrackerSync/<timestamp>.analog.csv
+% 
+% Pulse measurements are computed by the device from the time of each edge
+% since the previous report, and decoded into a struct with fields Pin,
+% High, Low and Period, each with fields Count, Min, Max and Mean (us). The
+% device reports them when requested, or periodically if so configured.
+% 
+% When several devices share a sync line (one configured as master and the
+% others as slaves), each device reports the time of every sync pulse in its
+% own clock, in syncPulses, a struct with columns Code, Time (s, device
+% clock) and HostTime (s, since the first TrackerSync of the MATLAB
+% session was created, so that host times of all devices are comparable).
+% TrackerSync.align fits the clock of one device to the clock of another,
+% which maps device times of toggles from one device to the other.
+% 
+% Zones set on the device close the loop without MATLAB: once a zone is
+% set, the position of the first pointer is sent to the device with every
+% frame, and the device drives the zone's output pin high while the
+% position is inside the zone, then reports the change. The Zone event
+% provides Zone, State, Frame (16 least significant bits) and Time (s,
+% device clock); the round trip is recorded in Metrics as 'closed_loop'.
+%   sync = TrackerSync('COM3');
+%   sync.setZone(1, [0, 0, 0.1], 8);
+% 
+% Without a serial device (comId is empty), serial data may only be
+% provided with ingest, e.g. when replaying a recorded session.
+% 
 % See also VirtualTracker.GUI
 
 % 2018-07-09. Leonardo Molina
-% 2018-07-16. Last modified.
-classdef TrackerSync < handle
+% 2026-10-18. Last modified.
+classdef TrackerSync < Event
     properties (SetAccess = private)
+        % glitches - Count of glitches rejected by the device, per pin.
+        glitches = zeros(1, 64)
+        
+        % monitor - Latest loop timing and interrupt load reported by the device.
+        monitor = struct()
+        
+        % pulses - Latest pulse measurements reported by the device, per pin.
+        pulses = struct('Pin', {}, 'High', {}, 'Low', {}, 'Period', {})
+        
+        % syncPulses - Sync pulses emitted or received by the device.
+        syncPulses = struct('Code', zeros(0, 1), 'Time', zeros(0, 1), 'HostTime', zeros(0, 1))
+        
+        % transport - Link to the device, as described by the firmware.
+        transport = struct()
+        
         % virtualTracker - VirtualTracker.GUI handle.
         virtualTracker
     end
     
     properties (Access = private)
+        % analogOutput - Output filename where analog samples are saved.
+        analogOutput
+        
         % comId - Serial port name.
         comId
         
+        % deviceOffset - Offset (us) accounting for wraps of the device clock.
+        deviceOffset = 0
+        
+        % deviceTime - Latest device time (us) received.
+        deviceTime = 0
+        
+        % deviceZones - Zones set on the device.
+        deviceZones = false(1, 8)
+        
+        % positionFrame - Frame of the last position sent to the device.
+        positionFrame = NaN
+        
+        % positionTime - Time (tic) the last position was sent to the device.
+        positionTime
+        
         % count - Count of pin toggles.
         count = zeros(1, 64)
         
@@ -48,6 +165,9 @@ classdef TrackerSync < handle
         % frameText - Frame info text.
         frameText
         
+        % metrics - Metrics handle.
+        metrics
+        
         % inputs - Queue for input data.
         inputs = zeros(0, 1, 'uint8');
         
@@ -63,37 +183,61 @@ classdef TrackerSync < handle
         % setup - Whether this is the first report for a given pin.
         setup = true(1, 64)
         
+        % hostStart - Process-wide reference (tic) of host times, shared by all instances.
+        hostStart
+        
         % startTime - Startup time.
         startTime
+        
+        % trace - Trace handle.
+        trace
     end
     
     properties (Constant)
-        % baudrate - Serial transmission speed.
-        baudrate = 115200
+        % baudrates - Serial transmission speeds tried, in order, until the firmware answers.
+        baudrates = [1000000, 2000000, 115200]
+        
+        % bufferSize - Size of the serial input buffer (bytes); holds about 0.3s at 2 Mbaud.
+        bufferSize = 65536
         
         % timeout - Interval for read and write, not smaller than 0.001.
         timeout = 1e-3
     end
     
     methods
-        function obj = TrackerSync(comId)
-            % obj = TrackerSync(comId)
+        function obj = TrackerSync(comId, cameraId, settingsFilename)
+            % obj = TrackerSync(comId, <cameraId>, <settingsFilename>)
             % Connect to serial port with the given comId and log position
-            % to disk with every pin toggle.
+            % to disk with every pin toggle. cameraId is passed to
+            % VirtualTracker.GUI (default 1). Camera and tracker settings
+            % are loaded from and saved to settingsFilename (default
+            % TrackerSync.settings.mat); if empty, they are neither loaded
+            % nor saved (e.g. during a replay).
+            
+            if nargin < 2
+                cameraId = 1;
+            end
+            className = mfilename('class');
+            if nargin < 3
+                settingsFilename = sprintf('%s.settings.mat', className);
+            end
             
             % Start serial device.
             obj.comId = comId;
-            try
-                obj.device = serial(comId, 'BaudRate', obj.baudrate);
-                obj.device.timeout = obj.timeout;
-                fopen(obj.device);
-            catch e
-                fprintf(2, 'Could not open the provided serial device.\nIf synchronization is not required, use VirtualTracker.GUI instead.\n\n');
-                rethrow(e);
+            if ~isempty(comId)
+                try
+                    obj.device = serial(comId, 'BaudRate', obj.baudrates(1), 'InputBufferSize', obj.bufferSize);
+                    obj.device.timeout = obj.timeout;
+                    fopen(obj.device);
+                catch e
+                    fprintf(2, 'Could not open the provided serial device.\nIf synchronization is not required, use VirtualTracker.GUI instead.\n\n');
+                    rethrow(e);
+                end
+                obj.detect();
             end
             
             % Start virtual tracker.
-            obj.virtualTracker = VirtualTracker.GUI(1);
+            obj.virtualTracker = VirtualTracker.GUI(cameraId);
             width = obj.virtualTracker.window.Position(3);
             height = 20;
             panel = uipanel('Title', 'VirtualTracker');
@@ -104,9 +248,11 @@ classdef TrackerSync < handle
             
             obj.virtualTracker.pushPanel(panel);
             obj.virtualTracker.register('Close', @obj.delete);
-            className = mfilename('class');
-            obj.settingsFilename = sprintf('%s.settings.mat', className);
-            obj.loadSettings(obj.settingsFilename);
+            obj.virtualTracker.register('Position', @obj.onPosition);
+            obj.settingsFilename = settingsFilename;
+            if ~isempty(settingsFilename)
+                obj.loadSettings(settingsFilename);
+            end
             
             % Create log file.
             root = getenv('USERPROFILE');
@@ -116,14 +262,19 @@ classdef TrackerSync < handle
             end
             % Session name starts with VT and follows with a timestamp.
             session = sprintf('VT%s', datestr(now, 'yyyymmddHHMMSS'));
-            obj.output = fullfile(folder, sprintf('%s.csv', session));
+            obj.output = Files.unique(fullfile(folder, sprintf('%s.csv', session)));
+            % Analog samples share the name of the log, which is unique.
+            obj.analogOutput = regexprep(obj.output, '\.csv$', '.analog.csv');
             % Write file header.
             fid = fopen(obj.output, 'a');
-            fprintf(fid, 'time, x, y, pin, count\n');
+            fprintf(fid, 'time, x, y, pin, count, device\n');
             fclose(fid);
             
             % Read serial port regularly.
+            obj.trace = Trace.Instance();
+            obj.metrics = Metrics.Instance();
             obj.startTime = tic;
+            obj.hostStart = Global.get('TrackerSyncHostStart', obj.startTime);
             obj.loopHandle = Scheduler.Repeat(@obj.loop, 2 * obj.timeout);
         end
         
@@ -131,14 +282,136 @@ classdef TrackerSync < handle
             % TrackerSync.delete()
             % Release serial device and save GUI settings.
             
-            obj.saveSettings(obj.settingsFilename);
+            if ~isempty(obj.settingsFilename)
+                obj.saveSettings(obj.settingsFilename);
+            end
             delete(obj.loopHandle);
-            fclose(obj.device);
-            delete(obj.device);
+            if ~isempty(obj.device)
+                fclose(obj.device);
+                delete(obj.device);
+            end
+        end
+        
+        function ingest(obj, bytes)
+            % TrackerSync.ingest(bytes)
+            % Queue and process serial data as if it had been received from
+            % the serial device.
+            
+            obj.inputs = [obj.inputs; uint8(bytes(:))];
+            obj.process(Inf);
+        end
+        
+        function requestPulses(obj)
+            % TrackerSync.requestPulses()
+            % Request pulse measurements of every input from the device;
+            % they are received asynchronously (see pulses).
+            
+            obj.send(4, []);
+        end
+        
+        function setZone(obj, zone, region, pin)
+            % TrackerSync.setZone(zone, region, <pin>)
+            % Set a zone on the device (1 to 8), which drives the given
+            % output pin high while the position is inside the zone. region
+            % is a circle [x, y, r] or a rectangle [x1, y1, x2, y2] given by
+            % opposite corners, as in VirtualTracker.GUI, or empty to clear
+            % the zone.
+            
+            if nargin < 4
+                pin = -1;
+            end
+            if ~isnumeric(zone) || ~isscalar(zone) || zone < 1 || zone > numel(obj.deviceZones)
+                error('Value provided for zone is invalid.');
+            end
+            switch numel(region)
+                case 0
+                    shape = 0;
+                case 3
+                    shape = 1;
+                case 4
+                    shape = 2;
+                otherwise
+                    error('Value provided for region is invalid.');
+            end
+            parameters = typecast(TrackerSync.fixed(region), 'uint8');
+            obj.send(7, [zone - 1, shape, typecast(int8(pin), 'uint8'), parameters]);
+            obj.deviceZones(zone) = shape > 0;
         end
     end
     
     methods (Access = private)
+        function onPosition(obj, data)
+            % TrackerSync.onPosition(data)
+            % Send the position of the first pointer to the device while
+            % zones are set on the device.
+            
+            if any(obj.deviceZones)
+                frame = mod(data.Frame, 2 ^ 16);
+                obj.positionFrame = frame;
+                obj.positionTime = tic;
+                if isempty(data.X)
+                    position = [NaN, NaN];
+                else
+                    position = [data.X(1), data.Y(1)];
+                end
+                obj.send(8, [typecast(TrackerSync.fixed(position), 'uint8'), typecast(uint16(frame), 'uint8')]);
+            end
+        end
+        
+        function send(obj, type, payload)
+            % TrackerSync.send(type, payload)
+            % Send an extended packet to the serial device.
+            
+            if ~isempty(obj.device)
+                fwrite(obj.device, uint8([128 + type, numel(payload), payload(:)']), 'uint8');
+            end
+        end
+        
+        function detect(obj)
+            % TrackerSync.detect()
+            % Find the baud rate of the firmware: send a hello at each baud
+            % rate in turn until the firmware answers. Bytes received before
+            % the answer may have been received at the wrong baud rate and
+            % are discarded; bytes received after it are queued.
+            
+            for b = 1:numel(obj.baudrates)
+                obj.device.BaudRate = obj.baudrates(b);
+                % Boards may reset when the port opens; allow them to boot.
+                if b == 1
+                    duration = 3;
+                else
+                    duration = 0.3;
+                end
+                received = zeros(0, 1, 'uint8');
+                start = tic;
+                helloTime = -Inf;
+                while toc(start) < duration
+                    if toc(start) - helloTime >= 0.1
+                        helloTime = toc(start);
+                        obj.send(9, []);
+                    end
+                    available = obj.device.BytesAvailable;
+                    if available > 0
+                        received = [received; uint8(fread(obj.device, available, 'uint8'))];
+                        % Hello: header, length and 7 bytes of payload.
+                        candidates = find(received(1:end - 8) == 128 + 9 & received(2:end - 7) == 7)';
+                        for k = candidates
+                            payload = received(k + 2:k + 8);
+                            native = bitand(payload(2), 1) == 1;
+                            baudrate = double(typecast(payload(3:6), 'uint32'));
+                            if payload(1) >= 1 && (native || baudrate == obj.baudrates(b))
+                                obj.extended(9, payload);
+                                obj.inputs = received(k + 9:end);
+                                return;
+                            end
+                        end
+                    end
+                    pause(0.01);
+                end
+            end
+            fprintf(2, 'The serial device did not answer the handshake; assuming %i baud.\n', obj.baudrates(end));
+        end
+        
         function loadSettings(obj, filename)
             % TrackerSync.loadSettings()
             % Apply previously saved settings, or else defaults.
@@ -156,13 +429,21 @@ classdef TrackerSync < handle
             % Only need to track one pointer.
             settings.tracker.quantity = 1;
             
+            % Apply in one pass, skipping values already in place: each
+            % change reconfigures the device or restarts the tracker.
+            % Resolution goes first since changing it may reset exposure.
             names = fieldnames(settings.camera);
+            names = [intersect({'resolution'}, names); setdiff(names, {'resolution'}, 'stable')];
             for i = 1:numel(names)
-                obj.virtualTracker.camera.(names{i}) = settings.camera.(names{i});
+                if ~isequal(obj.virtualTracker.camera.(names{i}), settings.camera.(names{i}))
+                    obj.virtualTracker.camera.(names{i}) = settings.camera.(names{i});
+                end
             end
             names = fieldnames(settings.tracker);
             for i = 1:numel(names)
-                obj.virtualTracker.tracker.(names{i}) = settings.tracker.(names{i});
+                if ~isequal(obj.virtualTracker.tracker.(names{i}), settings.tracker.(names{i}))
+                    obj.virtualTracker.tracker.(names{i}) = settings.tracker.(names{i});
+                end
             end
         end
         
@@ -170,49 +451,201 @@ classdef TrackerSync < handle
             % TrackerSync.loop()
             % Save position to disk when serial data is received.
             
+            % Serial ticks are not part of any frame.
+            span = obj.trace.start('TrackerSync.loop');
+            
             % Read a maximum number of bytes at a time.
-            available = min(obj.device.BytesAvailable, 128);
+            if isempty(obj.device)
+                available = 0;
+            else
+                available = min(obj.device.BytesAvailable, 4096);
+            end
             if available > 0
                 recent = fread(obj.device, available, 'uint8');
                 obj.inputs = [obj.inputs; recent];
+                obj.metrics.count('serial_bytes', available);
+                obj.invoke('Serial', recent);
             end
+            obj.metrics.gauge('serial_backlog_bytes', numel(obj.inputs));
             
             % Process a maximum number of bytes at a time.
-            nProcessed = 0;
-            while numel(obj.inputs) > 0 && nProcessed <= 128
-                head = obj.inputs(1);
-                if bitand(head, 128) == 0
+            obj.process(4096);
+            obj.trace.stop(span);
+        end
+        
+        function process(obj, limit)
+            % TrackerSync.process(limit)
+            % Parse up to limit bytes from the input queue.
+            
+            % Pop the queue once, rather than after every packet.
+            inputs = obj.inputs;
+            nInputs = numel(inputs);
+            k = 1;
+            while k <= nInputs && k - 1 <= limit
+                head = inputs(k);
+                n = 1;
+                if bitand(head, 128) == 128
+                    % 1xxxxxxx: 7-bit type, followed by length and payload.
+                    if nInputs - k + 1 < 2 || nInputs - k + 1 < 2 + double(inputs(k + 1))
+                        % Wait for the rest of the packet.
+                        break;
+                    end
+                    n = 2 + double(inputs(k + 1));
+                    obj.extended(bitand(head, 127), inputs(k + 2:k + n - 1));
+                else
                     % 0xxxxxxx: 6-bit target and 1-bit state.
-                    pin = bitand(head, 63);
-                    state = bitand(head, 64) ~= 64;
-                    % Update count.
-                    id = pin + 1;
-                    if obj.setup(id)
-                        % A high state during start shifts the count by 1.
-                        obj.setup(id) = false;
-                        if state
-                            obj.count(id) = 1;
-                        end
+                    obj.toggle(head, NaN);
+                end
+                k = k + n;
+            end
+            obj.inputs = obj.inputs(k:end);
+        end
+        
+        function toggle(obj, head, time)
+            % TrackerSync.toggle(head, time)
+            % Process a pin toggle encoded in a single byte, which occurred
+            % at the given device time (s) or NaN if unknown.
+            
+            pin = bitand(head, 63);
+            state = bitand(head, 64) ~= 64;
+            % Update count.
+            id = pin + 1;
+            if obj.setup(id)
+                % A high state during start shifts the count by 1.
+                obj.setup(id) = false;
+                if state
+                    obj.count(id) = 1;
+                end
+            else
+                obj.count(id) = obj.count(id) + 1;
+                ids = find(obj.count > 0);
+                counts = num2cell(obj.count(ids));
+                pins = num2cell(ids - 1);
+                obj.frameOutput.String = strjoin(Tools.compose('P%02i:%i', [pins(:) counts(:)]'), ' ');
+            end
+            
+            % Create an entry in the log file.
+            % For most applications, writing small volumes frequently will yield 
+            % better performance than writing larger volumes infrequently.
+            if state
+                start = tic;
+                fid = fopen(obj.output, 'a');
+                fprintf(fid, '%.2f,%.2f,%.2f,%i,%i,%.6f\n', toc(obj.startTime), obj.virtualTracker.position(1), obj.virtualTracker.position(2), pin, obj.count(id), time);
+                fclose(fid);
+                obj.metrics.observe('logging', toc(start));
+            end
+        end
+        
+        function time = unwrap(obj, bytes)
+            % time = TrackerSync.unwrap(bytes)
+            % Convert a device time (uint32, us) to seconds, accounting for
+            % wraps of the device clock every 2^32 us. Times may arrive
+            % slightly out of order (e.g. analog blocks).
+            
+            time = obj.deviceOffset + double(typecast(bytes(:)', 'uint32'));
+            if time < obj.deviceTime - 2 ^ 31
+                obj.deviceOffset = obj.deviceOffset + 2 ^ 32;
+                time = time + 2 ^ 32;
+            elseif time > obj.deviceTime + 2 ^ 31 && obj.deviceOffset > 0
+                % Received after the wrap, but from before it.
+                time = time - 2 ^ 32;
+            end
+            obj.deviceTime = max(obj.deviceTime, time);
+            time = time / 1e6;
+        end
+        
+        function extended(obj, type, payload)
+            % TrackerSync.extended(type, payload)
+            % Process an extended packet.
+            
+            switch type
+                case 1
+                    % Glitches rejected by the device.
+                    pin = double(payload(1));
+                    obj.glitches(pin + 1) = double(typecast(payload(2:5), 'uint32'));
+                    obj.metrics.gauge(sprintf('glitches_p%02i', pin), obj.glitches(pin + 1));
+                case 2
+                    % Loop timing and interrupt load of the device.
+                    obj.monitor.LoopHistogram = double(typecast(payload(1:16), 'uint16'))';
+                    obj.monitor.LoopMax = double(typecast(payload(17:18), 'uint16'));
+                    obj.monitor.StepMax = double(typecast(payload(19:20), 'uint16'));
+                    obj.monitor.InterruptRate = double(typecast(payload(21:24), 'uint32'));
+                    obj.monitor.TxHighWater = double(typecast(payload(25:26), 'uint16'));
+                    obj.monitor.CatchUp = double(typecast(payload(27:28), 'uint16'));
+                    obj.metrics.gauge('device_loop_max_us', obj.monitor.LoopMax);
+                    obj.metrics.gauge('device_step_max_us', obj.monitor.StepMax);
+                    obj.metrics.gauge('device_interrupts_per_s', obj.monitor.InterruptRate);
+                    obj.metrics.gauge('device_tx_high_water_bytes', obj.monitor.TxHighWater);
+                    obj.metrics.gauge('device_catch_up', obj.monitor.CatchUp);
+                case 3
+                    % Block of analog samples.
+                    time = obj.unwrap(payload(1:4));
+                    period = double(typecast(payload(5:6), 'uint16'));
+                    mask = double(typecast(payload(7:8), 'uint16'));
+                    nSamples = double(payload(9));
+                    data.Channels = find(bitget(mask, 1:16)) - 1;
+                    nChannels = numel(data.Channels);
+                    data.Values = reshape(TrackerSync.unpack(payload(10:end), nSamples), nChannels, [])';
+                    nScans = size(data.Values, 1);
+                    data.Time = time + (0:nScans - 1)' * period / 1e6;
+                    
+                    start = tic;
+                    if exist(obj.analogOutput, 'file') ~= 2
+                        fid = fopen(obj.analogOutput, 'a');
+                        fprintf(fid, 'time%s\n', sprintf(', a%i', data.Channels));
                     else
-                        obj.count(id) = obj.count(id) + 1;
-                        ids = find(obj.count > 0);
-                        counts = num2cell(obj.count(ids));
-                        pins = num2cell(ids - 1);
-                        obj.frameOutput.String = strjoin(Tools.compose('P%02i:%i', [pins(:) counts(:)]'), ' ');
+                        fid = fopen(obj.analogOutput, 'a');
                     end
-                    
-                    % Create an entry in the log file.
-                    % For most applications, writing small volumes frequently will yield 
-                    % better performance than writing larger volumes infrequently.
-                    if state
-                        fid = fopen(obj.output, 'a');
-                        fprintf(fid, '%.2f,%.2f,%.2f,%i,%i\n', toc(obj.startTime), obj.virtualTracker.position(1), obj.virtualTracker.position(2), pin, obj.count(id));
-                        fclose(fid);
+                    fprintf(fid, ['%.6f', repmat(',%i', 1, nChannels), '\n'], [data.Time, data.Values]');
+                    fclose(fid);
+                    obj.metrics.observe('logging', toc(start));
+                    obj.invoke('Analog', data);
+                case 4
+                    % Pulse measurements of a pin.
+                    pulse.Pin = double(payload(1));
+                    names = {'High', 'Low', 'Period'};
+                    for i = 1:numel(names)
+                        offset = 1 + 14 * (i - 1);
+                        pulse.(names{i}).Count = double(typecast(payload(offset + 1:offset + 2), 'uint16'));
+                        pulse.(names{i}).Min = double(typecast(payload(offset + 3:offset + 6), 'uint32'));
+                        pulse.(names{i}).Max = double(typecast(payload(offset + 7:offset + 10), 'uint32'));
+                        pulse.(names{i}).Mean = double(typecast(payload(offset + 11:offset + 14), 'uint32'));
                     end
-                end
-                % Pop the queue.
-                obj.inputs(1) = [];
-                nProcessed = nProcessed + 1;
+                    obj.pulses(pulse.Pin + 1) = pulse;
+                    obj.metrics.gauge(sprintf('pulse_period_p%02i_us', pulse.Pin), pulse.Period.Mean);
+                    obj.invoke('Pulses', pulse);
+                case 5
+                    % Sync pulse emitted or received by the device.
+                    obj.syncPulses.Code(end + 1, 1) = double(payload(1));
+                    obj.syncPulses.Time(end + 1, 1) = obj.unwrap(payload(2:5));
+                    obj.syncPulses.HostTime(end + 1, 1) = toc(obj.hostStart);
+                case 6
+                    % Pin toggle with its device time.
+                    obj.toggle(payload(1), obj.unwrap(payload(2:5)));
+                case 7
+                    % Zone entry or exit on the device.
+                    data.Zone = double(payload(1)) + 1;
+                    data.State = payload(2) == 1;
+                    data.Frame = double(typecast(payload(3:4), 'uint16'));
+                    data.Time = obj.unwrap(payload(5:8));
+                    if data.Frame == obj.positionFrame
+                        obj.metrics.observe('closed_loop', toc(obj.positionTime));
+                    end
+                    obj.invoke('Zone', data);
+                case 8
+                    % Overruns and misses of each task of the device.
+                    values = reshape(double(typecast(payload(:)', 'uint32')), 2, []);
+                    obj.monitor.Overruns = values(1, :);
+                    obj.monitor.Misses = values(2, :);
+                    obj.metrics.gauge('device_task_overruns', sum(obj.monitor.Overruns));
+                    obj.metrics.gauge('device_task_misses', sum(obj.monitor.Misses));
+                case 9
+                    % Description of the link, in reply to a hello.
+                    obj.transport.Version = double(payload(1));
+                    obj.transport.NativeUSB = bitand(payload(2), 1) == 1;
+                    obj.transport.Instrumented = bitand(payload(2), 2) == 2;
+                    obj.transport.Baudrate = double(typecast(payload(3:6), 'uint32'));
+                    obj.transport.PacketSize = double(payload(7));
             end
         end
         
@@ -231,5 +664,36 @@ classdef TrackerSync < handle
             save(filename, 'settings');
         end
     end
+    
+    methods (Static, Access = private)
+        function values = fixed(values)
+            % values = TrackerSync.fixed(values)
+            % Convert coordinates to fixed point (int16, 14 fractional
+            % bits); NaN becomes the smallest int16, meaning no position.
+            
+            values = double(values(:)');
+            missing = isnan(values);
+            values = int16(round(values * 2 ^ 14));
+            values(missing) = intmin('int16');
+        end
+        
+        function values = unpack(packed, n)
+            % values = TrackerSync.unpack(packed, n)
+            % Unpack n 10-bit values packed 4 in 5 bytes, least significant
+            % bits first.
+            
+            packed = double(packed(:));
+            nGroups = ceil(n / 4);
+            packed(end + 1:5 * nGroups) = 0;
+            b = reshape(packed(1:5 * nGroups), 5, nGroups);
+            values = [
+                b(1, :) + mod(b(2, :), 4) * 256
+                floor(b(2, :) / 4) + mod(b(3, :), 16) * 64
+                floor(b(3, :) / 16) + mod(b(4, :), 64) * 16
+                floor(b(4, :) / 64) + b(5, :) * 4
+            ];
+            values = values(1:n);
+        end
+    end
 end
 %#ok<*STRNU>
\ No newline at end of file
@@ -13,7 +13,10 @@
 %   Roi(roi)           - Region of interest changed.
 % 
 %   where position is a  struct with fields X and Y with coordinates of
-%   tracked pointers; and roi is the region of interest.
+%   tracked pointers, Time (s) since startup, Frame (frame number given by
+%   Camera.frameCount) and Zones, a uint64 bitmask per pointer where bit r
+%   is set while the pointer is inside the r-th region (regions beyond the
+%   64th are not reported); and roi is the region of interest.
 %   
 % Data is saved to disk as a CSV file with 6 columns:
 %   time, x-coordinate, y-coordinate, pointer id, zone id, trial number.
@@ -36,12 +39,19 @@
 %   and "with all faults". You should test throughly for proper execution and
 %   proper data output before running any behavioral experiments.
 % 
+%   Time spent in each stage of the pipeline (tracking, zone tests,
+%   callbacks, events and saving) is recorded when tracing is enabled:
+%     trace = Trace.Instance();
+%     trace.enabled = true;
+%     ...
+%     trace.save('trace.json');
+% 
 %   Tested on MATLAB 2018a.
 % 
 % See also Events, VirtualTracker.GUI, VirtualTracker.example, CircularMaze, LinearMaze, TwoChoice.
 
 % 2016-09-02. Leonardo Molina.
-% 2018-07-13. Last modified.
+% 2026-10-18. Last modified.
 classdef VirtualTracker < Event
     properties (Dependent)
         % play - Start/stop video acquisition.
@@ -75,12 +85,14 @@ classdef VirtualTracker < Event
     properties (Access = private)
         callbacks = {}                  % Callback for each region.
         data = zeros(5, 0)              % Data for this trial: time, x, y, pointer, zone. 
+        metrics                         % Metrics handle.
         regions = {}                    % Region for each each callback.
         saved = false                   % Whether current trial has been saved.
         states = false(0, 0)            % State (in/out) for all pointers and zones.
         startTime                       % Startup time.
         targetHandles = {}              % Handle to target manager.
         target                          % Target handle.
+        trace                           % Trace handle.
         
         mPlay = false                   % Playing state.
         mPosition = zeros(2, 1)
@@ -150,6 +162,8 @@ classdef VirtualTracker < Event
             % VirtualTracker.save()
             % Save new data to disk. The output file is appended with new data.
             
+            span = obj.trace.start('VirtualTracker.save');
+            start = tic;
             nTrialData = size(obj.data, 2);
             if nTrialData > 0
                 % Prepare data for saving: time, x, y, pointer, zone, trial.
@@ -161,6 +175,8 @@ classdef VirtualTracker < Event
                 obj.saved = true;
                 obj.data = zeros(5, 0);
             end
+            obj.metrics.observe('save', toc(start));
+            obj.trace.stop(span);
         end
         
         function play = get.play(obj)
@@ -197,6 +213,8 @@ classdef VirtualTracker < Event
             obj.tracker = tracker;
             obj.camera = camera;
             obj.target = Target();
+            obj.trace = Trace.Instance();
+            obj.metrics = Metrics.Instance();
             obj.tracker.register('Roi', @obj.tmp);
             
             % Read position at every frame.
@@ -211,7 +229,7 @@ classdef VirtualTracker < Event
                     mkdir(folder);
                 end
                 session = sprintf('VT%s', datestr(now, 'yyyymmddHHMMSS'));
-                output = fullfile(folder, sprintf('%s.csv', session));
+                output = Files.unique(fullfile(folder, sprintf('%s.csv', session)));
             end
             obj.output = output;
             
@@ -234,7 +252,12 @@ classdef VirtualTracker < Event
             % Track position for this frame and test for collisions.
             
             % Track position.
+            sequence = obj.camera.frameCount;
+            span = obj.trace.start('Tracker.track', sequence);
+            start = tic;
             pointers2 = obj.tracker.track(frame);
+            obj.metrics.observe('track', toc(start));
+            obj.trace.stop(span);
             if ~isequal(pointers2, obj.position)
                 pointers1 = obj.position;
                 obj.mPosition = pointers2;
@@ -255,9 +278,12 @@ classdef VirtualTracker < Event
                 
                 handles = obj.targetHandles;
                 time = toc(obj.startTime);
+                start = tic;
                 for p = 1:n2s
                     % For each pointer.
+                    span = obj.trace.start('Target.test', sequence);
                     states2 = obj.target.test([x1s(p), x2s(p)], [y1s(p), y2s(p)], [false, false]);
+                    obj.trace.stop(span);
                     nRegions = numel(obj.regions);
                     for r = 1:nRegions
                         % For each region.
@@ -268,7 +294,9 @@ classdef VirtualTracker < Event
                             if ~obj.states(r, p)
                                 % Previously outside a zone.
                                 obj.states(r, p) = true;
+                                span = obj.trace.start('Callbacks.invoke', sequence);
                                 Callbacks.invoke(obj.callbacks{r}, struct('X', x2s(p), 'Y', y2s(p), 'State', true, 'Handle', handles{r}));
+                                obj.trace.stop(span);
                             end
                         else
                             % Currently outsize a zone.
@@ -276,17 +304,30 @@ classdef VirtualTracker < Event
                             if obj.states(r, p)
                                 % Previously inside a zone.
                                 obj.states(r, p) = false;
+                                span = obj.trace.start('Callbacks.invoke', sequence);
                                 Callbacks.invoke(obj.callbacks{r}, struct('X', x2s(p), 'Y', y2s(p), 'State', false, 'Handle', handles{r}));
+                                obj.trace.stop(span);
                             end
                         end
                         % Append trial data.
                         obj.data(:, end + 1) = [time; x2s(p); y2s(p); p; zone];
                     end
                 end
+                obj.metrics.observe('zones', toc(start));
                 % Notify clients of a change in position.
                 obj.mPosition = [x2s; y2s];
-                obj.invoke('Position', struct('X', x2s, 'Y', y2s));
+                span = obj.trace.start('Event.invoke', sequence);
+                start = tic;
+                % Build the mask on uint64; doubles would lose bits above 2^53.
+                zones = zeros(1, n2s, 'uint64');
+                for r = find(any(obj.states(1:min(end, 64), 1:n2s), 2))'
+                    zones = bitset(zones, r, double(obj.states(r, 1:n2s)));
+                end
+                obj.invoke('Position', struct('X', x2s, 'Y', y2s, 'Time', time, 'Frame', sequence, 'Zones', zones));
+                obj.metrics.observe('position_event', toc(start));
+                obj.trace.stop(span);
             end
+            obj.metrics.observe('capture_to_callback', toc(obj.camera.frameTime));
         end
     end
 end
\ No newline at end of file